@@ -0,0 +1,76 @@
+#ifndef ADPCM_H
+#define ADPCM_H
+#include <Arduino.h>
+#include "fixedpoint.h"
+
+/* 4-bit IMA (DVI) ADPCM codec for sample memory.
+ * Each code stores the difference from the previous reconstructed sample, scaled by a step
+ * size that adapts to the signal: 4 bits per sample instead of the 10 of a packed delay
+ * line (delayline.h), at about the same noise as an 8-bit line on guitar material.
+ * The stream is sequential: decoding a code needs the state left by the code before, so an
+ * encoder and the decoder that reads its codes back must start from the same AdpcmState.
+ * adpcmEncode() runs the decoder's reconstruction itself to stay in step with it; fed a
+ * sample it decoded from the same state, it returns the same code, so re-encoding a stream
+ * unchanged loses nothing.
+ * Both directions are straight-line integer code: three compares, two flash reads and a
+ * clamp, the same cycles for any sample (ADPCM_*_CYCLES, for the effect budgets).*/
+#define ADPCM_STEPS 89
+#define ADPCM_DECODE_CYCLES 60 // Estimated, on the ATmega328P
+#define ADPCM_ENCODE_CYCLES (ADPCM_DECODE_CYCLES + 35)
+
+extern const uint16_t adpcmStepTable[ADPCM_STEPS]; // In flash (PROGMEM)
+extern const int8_t adpcmIndexTable[8];            // In flash (PROGMEM)
+
+/*Codec state: the last reconstructed sample and the step size index*/
+struct AdpcmState {
+    q15_t predictor;
+    uint8_t index; // 0 to ADPCM_STEPS - 1
+};
+
+/**
+ * @brief: Puts a codec back at the start of a stream: silence, smallest step.
+ */
+static inline void adpcmReset(AdpcmState &state) {
+    state.predictor = 0;
+    state.index = 0;
+}
+
+/**
+ * @brief: Reconstructs the next sample from a 4-bit code (bit 3 sign, bits 2:0 magnitude).
+ */
+static inline q15_t adpcmDecode(AdpcmState &state, uint8_t code) {
+    uint16_t step = pgm_read_word(&adpcmStepTable[state.index]);
+    uint16_t delta = step >> 3;
+    if (code & 4) delta += step;
+    if (code & 2) delta += step >> 1;
+    if (code & 1) delta += step >> 2;
+    state.predictor = q15Saturate((code & 8) ? (int32_t)state.predictor - delta : (int32_t)state.predictor + delta);
+
+    int8_t index = (int8_t)state.index + (int8_t)pgm_read_byte(&adpcmIndexTable[code & 7]);
+    state.index = (index < 0) ? 0 : ((index >= ADPCM_STEPS) ? ADPCM_STEPS - 1 : index);
+    return state.predictor;
+}
+
+/**
+ * @brief: Quantizes the difference between sample and the prediction to a 4-bit code and
+ * advances the state as adpcmDecode() will when it reads the code back.
+ */
+static inline uint8_t adpcmEncode(AdpcmState &state, q15_t sample) {
+    uint16_t step = pgm_read_word(&adpcmStepTable[state.index]);
+    int32_t diff = (int32_t)sample - state.predictor;
+    uint8_t code = 0;
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+    uint16_t magnitude = (uint16_t)diff; // At most 65535
+    if (magnitude >= step) { code |= 4; magnitude -= step; }
+    step >>= 1;
+    if (magnitude >= step) { code |= 2; magnitude -= step; }
+    step >>= 1;
+    if (magnitude >= step) code |= 1;
+    adpcmDecode(state, code);
+    return code;
+}
+
+#endif
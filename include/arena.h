@@ -0,0 +1,105 @@
+#ifndef ARENA_H
+#define ARENA_H
+#include <stdint.h>
+#include "main.h"
+#include "params.h"
+
+/* Static SRAM arena for effect state.
+ * Every effect declares a 'State' struct holding everything it keeps between samples
+ * (delay lines, filter memories, phases). EffectArenaLayout<Effects...> lays the States
+ * of the registered effects out back to back in one statically allocated block, so
+ * offsets are fixed at build time, disabled effects take no SRAM and no effect can
+ * reach another effect's memory. Because nothing is shared, switching effects never
+ * has to clear anything and an effect resumes where it left off.
+ * The whole block must fit EFFECT_ARENA_BYTES, what is left of the ATmega328P's 2 KB
+ * after STACK_RESERVE_BYTES, the parameter banks (params.h), the Serial rings, the
+ * other static data and the optional modules built in (checked in arena.cpp). After
+ * linking, tools/check_sram.py reads the real symbol sizes and fails the build if the
+ * other static data outgrows STATIC_SRAM_BYTES or .data + .bss leave less than
+ * STACK_RESERVE_BYTES, and arenaReport() stops the pedal at boot if less than
+ * STACK_RESERVE_BYTES is free.*/
+#define SRAM_BYTES 2048
+#define STACK_RESERVE_BYTES 256 // Deepest loop() call chain plus one nested ISR frame
+
+/*Serial rings, set in platformio.ini: requests are PARAM_REQUEST_BYTES long and one
+ * reply (at most 31 bytes) is sent at a time, so the core's 64-byte rings are not needed*/
+#ifndef SERIAL_RX_BUFFER_SIZE
+#define SERIAL_RX_BUFFER_SIZE 64 // Arduino core default
+#endif
+#ifndef SERIAL_TX_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_SIZE 64
+#endif
+#define SERIAL_SRAM_BYTES (SERIAL_RX_BUFFER_SIZE + SERIAL_TX_BUFFER_SIZE + 29) // Rings plus the HardwareSerial object
+
+/*Every other global of the AVR build, by symbol:
+ *   modules: inputs 32, presets 29, transition 13, main 13, serial requests 12,
+ *            effect chain 9 plus its 4-byte default                               116
+ *   Arduino core: millis() counters 9, HardwareSerial vtable 18,
+ *                 TimerOne's overflow callback 2                                  29
+ * Constant tables are in flash, and arenaReport() does not link in malloc's state.*/
+#define STATIC_SRAM_BYTES 145
+
+/*Optional modules (main.h), taken off the arena when built in. Each module checks its
+ * globals against its figure; the echo line gives way to make room (echo.h)*/
+#ifdef ISR_PROFILE
+#define ISR_PROFILE_SRAM_BYTES 392 // isrProfileStats, 28 bytes per EffectMode
+#else
+#define ISR_PROFILE_SRAM_BYTES 0
+#endif
+#ifdef TELEMETRY
+#define TELEMETRY_SRAM_BYTES 93 // telemetryRing (16 records of 5 bytes, indexes), telemetryCapture
+#else
+#define TELEMETRY_SRAM_BYTES 0
+#endif
+#ifdef AUDIO_BLOCK_MODE
+#define AUDIO_BLOCK_SRAM_BYTES (8 * AUDIO_BLOCK_SIZE + 6) // Ping-pong input and output blocks, indexes and flags
+#else
+#define AUDIO_BLOCK_SRAM_BYTES 0
+#endif
+#define OPTIONAL_SRAM_BYTES (ISR_PROFILE_SRAM_BYTES + TELEMETRY_SRAM_BYTES + AUDIO_BLOCK_SRAM_BYTES)
+
+#define EFFECT_ARENA_BYTES \
+    (SRAM_BYTES - STACK_RESERVE_BYTES - PARAM_BANK_BYTES - SERIAL_SRAM_BYTES - STATIC_SRAM_BYTES - OPTIONAL_SRAM_BYTES)
+
+/*The figures above are for the AVR, where nothing is aligned. Host builds pad States,
+ * banks and records to their widest member and check against this much more*/
+#if defined(__AVR__)
+#define SRAM_HOST_PADDING_BYTES 0
+#else
+#define SRAM_HOST_PADDING_BYTES 32
+#endif
+
+template <typename... Effects> struct EffectArenaLayout;
+
+template <> struct EffectArenaLayout<> {};
+
+template <typename First, typename... Rest> struct EffectArenaLayout<First, Rest...> {
+    typename First::State state;
+    EffectArenaLayout<Rest...> rest;
+};
+
+/*Finds an effect's State inside a layout at compile time*/
+template <typename Effect, typename Layout> struct EffectArenaLookup;
+
+template <typename Effect, typename... Rest> struct EffectArenaLookup<Effect, EffectArenaLayout<Effect, Rest...> > {
+    static inline typename Effect::State &get(EffectArenaLayout<Effect, Rest...> &layout) { return layout.state; }
+};
+
+template <typename Effect, typename First, typename... Rest> struct EffectArenaLookup<Effect, EffectArenaLayout<First, Rest...> > {
+    static inline typename Effect::State &get(EffectArenaLayout<First, Rest...> &layout) {
+        return EffectArenaLookup<Effect, EffectArenaLayout<Rest...> >::get(layout.rest);
+    }
+};
+
+/*Effect not registered: its code is never dispatched to, so the linker drops this
+ * placeholder together with it; it only exists so the module still compiles.*/
+template <typename Effect> struct EffectArenaLookup<Effect, EffectArenaLayout<> > {
+    static inline typename Effect::State &get(EffectArenaLayout<> &) {
+        static typename Effect::State unused;
+        return unused;
+    }
+};
+
+extern void arenaReport(void);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef AUDIOBLOCK_H
+#define AUDIOBLOCK_H
+#include "main.h"
+
+/* Block-based audio pipeline (enabled with AUDIO_BLOCK_MODE in main.h).
+ * The capture ISR only swaps one sample per period with a pair of ping-pong blocks:
+ * it fills audioInBlock[half] and plays audioOutBlock[half]. When a block is full the
+ * halves swap and the finished block is processed once by processAudioBlock(),
+ * so the effect dispatch, call overhead and parameter loads are paid per block.
+ * A sample waits one block to be collected and one block to be played back.*/
+#define AUDIO_BLOCK_LATENCY_SAMPLES (2 * AUDIO_BLOCK_SIZE)
+#define AUDIO_BLOCK_LATENCY_US ((AUDIO_BLOCK_LATENCY_SAMPLES * AUDIO_SAMPLE_PERIOD_CYCLES) / (F_CPU / 1000000UL))
+
+extern q15_t audioInBlock[2][AUDIO_BLOCK_SIZE];
+extern q15_t audioOutBlock[2][AUDIO_BLOCK_SIZE];
+extern volatile uint8_t audioBlockIndex;     // Next sample slot used by the ISR
+extern volatile uint8_t audioBlockHalf;      // Half currently owned by the ISR
+extern volatile bool audioBlockReady;        // The other half holds a full input block
+extern volatile uint16_t audioBlockOverruns; // Blocks that were not processed in time
+
+/**
+ * @brief: ISR side of the pipeline. Stores one input sample, returns the output sample
+ * for the same slot and swaps the halves when the block is complete.
+ * @param inputSample The centered Q15 input audio sample.
+ * @return The processed sample to play, before master volume.
+ */
+static inline q15_t audioBlockExchange(q15_t inputSample) {
+    uint8_t half = audioBlockHalf;
+    uint8_t index = audioBlockIndex;
+    audioInBlock[half][index] = inputSample;
+    q15_t outputSample = audioOutBlock[half][index];
+    if (++index >= AUDIO_BLOCK_SIZE) {
+        index = 0;
+        if (audioBlockReady) {
+            audioBlockOverruns++; // Previous block still unprocessed, it will be played again
+        }
+        audioBlockHalf = half ^ 1;
+        audioBlockReady = true;
+    }
+    audioBlockIndex = index;
+    return outputSample;
+}
+
+extern void audioBlockSetup(void);
+extern void audioBlockService(void);
+
+#endif
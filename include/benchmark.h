@@ -0,0 +1,31 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+#include "main.h"
+
+/* Simulator benchmark driver (enabled with BENCHMARK, set by [env:bench] in platformio.ini).
+ * loop() steps through every mode compiled in, CLEAN_MODE to LOOPER_MODE, holding each for
+ * BENCHMARK_MODE_MS, then stops. Before each ISR it leaves a tag in GPIOR0 saying what
+ * that ISR is going to render:
+ *  - the EffectMode, once the switch to it has finished and its lines had
+ *    BENCHMARK_SETTLE_MS to fill (an empty delay line reads cheaper than a full one);
+ *  - BENCHMARK_TAG_TRANSITION while a crossfade or dip runs (transition.h);
+ *  - BENCHMARK_TAG_SETTLING in between, BENCHMARK_TAG_DONE after the last mode.
+ * tools/simbench.c reads the tag on ISR entry and counts the exact cycles to RETI;
+ * tools/benchmark.py builds the image, runs it and writes the results as JSON.
+ * At boot benchmarkSetup() prints the cycles each mode is declared to take, ISR_FIXED_CYCLES
+ * plus its worstCaseCycles (effects.h; chains through effectChainCycles()), so the script
+ * can check the estimates the chain and transition budgets rely on against the measured
+ * maxima.
+ * GPIOR0 is a spare I/O register: the tag costs the ISR nothing.*/
+#define BENCHMARK_MODE_MS 200
+#define BENCHMARK_SETTLE_MS 60
+#define BENCHMARK_TAG_SETTLING 0xFD
+#define BENCHMARK_TAG_TRANSITION 0xFE
+#define BENCHMARK_TAG_DONE 0xFF
+
+#ifdef BENCHMARK
+extern void benchmarkSetup(void);
+extern void benchmarkService(void);
+#endif
+
+#endif
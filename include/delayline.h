@@ -0,0 +1,100 @@
+#ifndef DELAYLINE_H
+#define DELAYLINE_H
+#include <stdint.h>
+#include "fixedpoint.h"
+
+/* Packed, power-of-two delay line for Q15 samples.
+ * The length is 2^SIZE_LOG2 samples so wraparound is a mask on a 16-bit index
+ * instead of a modulo, and samples are stored at BITS resolution instead of 16 bits:
+ *  - BITS = 8  : one signed byte per sample (top 8 bits of the Q15 value).
+ *  - BITS = 10 : the full ADC resolution, packed as one byte with the top 8 bits plus
+ *                2 bits in a shared byte for every 4 samples (1.25 bytes per sample).
+ * Storage is signed, so a zeroed line is silence.
+ * write() stores the newest sample and advances; read(delay) returns the sample
+ * written delay samples ago (1 to SIZE), so effects read before they write.
+ * readInterpolated(delay, fraction) reads delay + fraction/256 samples ago (delay up to
+ * SIZE - 1), linearly interpolated, for modulated delays (see lfo.h).
+ *
+ * clear() runs in constant time, whatever the length: instead of zeroing the storage
+ * it resets 'filled', the number of samples written since the last clear. Writes are
+ * sequential, so a slot further back than 'filled' holds a stale sample from before
+ * the clear and read() returns silence for it. Bypass and mode changes can therefore
+ * reset a line from inside the ISR for the cost of two stores.*/
+template <uint8_t BITS, uint8_t SIZE_LOG2> class DelayLine;
+
+template <uint8_t SIZE_LOG2> class DelayLine<8, SIZE_LOG2> {
+public:
+    static const uint16_t SIZE = (uint16_t)1 << SIZE_LOG2;
+    static const uint16_t MASK = SIZE - 1;
+    static const uint16_t BYTES = SIZE;
+
+    inline q15_t read(uint16_t delay) const {
+        if (delay > filled) return 0; // Written before the last clear()
+        return (q15_t)((uint16_t)(uint8_t)data[(head - delay) & MASK] << 8);
+    }
+
+    inline q15_t readInterpolated(uint16_t delay, uint8_t fraction) const {
+        q15_t newer = read(delay);
+        q15_t older = read(delay + 1);
+        return newer + (q15_t)((((int32_t)older - newer) * fraction) >> 8);
+    }
+
+    inline void write(q15_t sample) {
+        data[head] = (int8_t)(sample >> 8);
+        head = (head + 1) & MASK;
+        if (filled < SIZE) filled++;
+    }
+
+    inline void clear(void) {
+        head = 0; // May hold another line's samples if the storage is shared (a union)
+        filled = 0;
+    }
+
+private:
+    int8_t data[SIZE];
+    uint16_t head;   // Next slot to write
+    uint16_t filled; // Samples written since the last clear(), up to SIZE
+};
+
+template <uint8_t SIZE_LOG2> class DelayLine<10, SIZE_LOG2> {
+public:
+    static const uint16_t SIZE = (uint16_t)1 << SIZE_LOG2;
+    static const uint16_t MASK = SIZE - 1;
+    static const uint16_t BYTES = SIZE + SIZE / 4;
+
+    inline q15_t read(uint16_t delay) const {
+        if (delay > filled) return 0; // Written before the last clear()
+        uint16_t index = (head - delay) & MASK;
+        uint8_t shift = (index & 3) << 1;
+        uint8_t low = (lsb[index >> 2] >> shift) & 0x03;
+        return (q15_t)(((uint16_t)(uint8_t)msb[index] << 8) | (low << 6));
+    }
+
+    inline q15_t readInterpolated(uint16_t delay, uint8_t fraction) const {
+        q15_t newer = read(delay);
+        q15_t older = read(delay + 1);
+        return newer + (q15_t)((((int32_t)older - newer) * fraction) >> 8);
+    }
+
+    inline void write(q15_t sample) {
+        uint8_t shift = (head & 3) << 1;
+        uint8_t *packed = &lsb[head >> 2];
+        msb[head] = (int8_t)(sample >> 8);
+        *packed = (*packed & ~(0x03 << shift)) | ((((uint16_t)sample >> 6) & 0x03) << shift);
+        head = (head + 1) & MASK;
+        if (filled < SIZE) filled++;
+    }
+
+    inline void clear(void) {
+        head = 0; // May hold another line's samples if the storage is shared (a union)
+        filled = 0;
+    }
+
+private:
+    int8_t msb[SIZE];      // Top 8 bits of each sample
+    uint8_t lsb[SIZE / 4]; // Bits 7:6 of four consecutive samples
+    uint16_t head;         // Next slot to write
+    uint16_t filled;       // Samples written since the last clear(), up to SIZE
+};
+
+#endif
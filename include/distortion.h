@@ -1,10 +1,57 @@
 #ifndef DISTORTION_H
 #define DISTORTION_H
 #include "main.h"
+#include "params.h"
+
+/* Waveshaper: the pre-gained sample indexes a transfer curve stored in flash.
+ * Each curve has DISTORTION_CURVE_POINTS entries covering -1.0..+1.0; the top 8 bits of
+ * the sample pick an entry and the low 8 bits interpolate to the next one, so the
+ * full ADC resolution reaches the output and every curve costs the same per sample.
+ * The tables are generated by tools/gen_distortion_curves.py (src/distortioncurves.cpp).*/
+#define DISTORTION_CURVE_POINTS 257
+#define DISTORTION_DC_SHIFT 8                  // DC removal after the asymmetric curves: ~20 Hz corner
+
+enum DistortionCurve {
+    DISTORTION_CURVE_TANH = 0, // Symmetric soft clip
+    DISTORTION_CURVE_TUBE,     // Asymmetric soft clip, adds even harmonics
+    DISTORTION_CURVE_FOLDBACK, // Folds back past the threshold instead of flattening
+    DISTORTION_CURVE_HARD,     // The original hard clipper at +/-150
+    NUM_DISTORTION_CURVES
+};
+
+extern const q15_t distortionCurves[NUM_DISTORTION_CURVES][DISTORTION_CURVE_POINTS]; // In flash (PROGMEM)
+
+/*Tunable settings (see params.h and the table in distortion.cpp)*/
+struct DistortionParams {
+    q7_8_t drive;  // Pre-gain into the curve
+    uint8_t curve; // DistortionCurve
+};
+#define DISTORTION_PARAM_COUNT 2
+extern const ParamInfo distortionParamTable[DISTORTION_PARAM_COUNT]; // In flash (PROGMEM)
 
 extern void pinConfigDistortion(void);
 extern void setupDistortion(void);
 extern void loopDistortion(void);
-extern void processDistortionAudio(int inputSample); 
+extern q15_t processDistortionAudio(q15_t inputSample);
+extern void distortionSelectCurve(DistortionCurve curve);
+extern void distortionNextCurve(void);
+
+/*Effect registry hooks (see effects.h)*/
+struct DistortionEffect {
+    struct State {
+        int32_t dcLevel; // Shaped signal average, scaled by 2^DISTORTION_DC_SHIFT
+    };
+    static constexpr uint16_t worstCaseCycles = 85;
+    static constexpr bool handles(EffectMode mode) { return mode == DISTORTION_MODE; }
+    static inline void pinConfig(void) { pinConfigDistortion(); }
+    static inline void setup(void) { setupDistortion(); }
+    static inline void loop(void) { loopDistortion(); }
+    static inline void restart(EffectMode) {}
+    static inline q15_t process(EffectMode, q15_t inputSample) { return processDistortionAudio(inputSample); }
+    typedef DistortionParams Params;
+    static constexpr uint8_t paramCount = DISTORTION_PARAM_COUNT;
+    static inline const ParamInfo *paramTable(void) { return distortionParamTable; }
+    static inline void deriveParams(Params &) {}
+};
 
 #endif
@@ -1,10 +1,64 @@
 #ifndef ECHO_H
 #define ECHO_H
 #include "main.h"
+#include "params.h"
+#include "arena.h"
+
+/*Echo delay line (see delayline.h): 10-bit x 2^9 = 512 samples (~16 ms at 31.4 kHz) in 640 bytes
+ * of the arena. It gives way to the optional modules (arena.h): 256 samples free 320 bytes,
+ * 128 free 480 and 64 free 560*/
+#define ECHO_DELAY_BITS 10
+#define ECHO_DELAY_SIZE_LOG2 (OPTIONAL_SRAM_BYTES == 0 ? 9 : OPTIONAL_SRAM_BYTES <= 320 ? 8 : OPTIONAL_SRAM_BYTES <= 480 ? 7 : 6)
+#define ECHO_MAX_US DELAY_SAMPLES_TO_US((1 << ECHO_DELAY_SIZE_LOG2) - 1)
+#define ECHO_TIME_DEFAULT_US (ECHO_MAX_US < 9563 ? ECHO_MAX_US : 9563) // 300 samples at 31.4 kHz
+
+/*The loop takes the line's bytes, less the Looper's own fields (looper.h)*/
+#define LOOPER_CODE_BYTES (((ECHO_DELAY_BITS << ECHO_DELAY_SIZE_LOG2) >> 3) - 24)
+#include "looper.h"
+
+/*Tunable settings (see params.h and the table in echo.cpp)*/
+struct EchoParams {
+    uint16_t time;         // Delay time in microseconds
+    q15_t feedback;        // Share of each repeat fed back
+    uint16_t delaySamples; // Derived: time in samples at the sample rate
+};
+#define ECHO_PARAM_COUNT 2
+extern const ParamInfo echoParamTable[ECHO_PARAM_COUNT]; // In flash (PROGMEM)
 
 extern void pinConfigEcho(void);
 extern void setupEcho(void);
 extern void loopEcho(void);
-extern void processEchoAudio(int inputSample);
+extern void restartEcho(void);
+extern q15_t processEchoAudio(q15_t inputSample);
+extern void deriveEchoParams(EchoParams &params);
+
+#define ECHO_CYCLES 150
+
+/*Effect registry hooks (see effects.h). The echo module also serves LOOPER_MODE (looper.h)*/
+struct EchoEffect {
+    struct State {
+        /*Only one of the modes runs at a time, so the loop takes the echo line's arena bytes*/
+        union {
+            DelayLine<ECHO_DELAY_BITS, ECHO_DELAY_SIZE_LOG2> delay; // ECHO_MODE
+            Looper looper;                                          // LOOPER_MODE
+        };
+        uint8_t runningMode; // Mode the shared bytes are set up for, CLEAN_MODE after restart()
+        volatile uint8_t looperRequest; // LooperRequest, set by loop() and taken at the next slot;
+                                        // cleared by restartLooper() and when the mode leaves LOOPER_MODE
+    };
+    static constexpr uint16_t worstCaseCycles = (LOOPER_CYCLES > ECHO_CYCLES) ? LOOPER_CYCLES : ECHO_CYCLES;
+    static constexpr bool handles(EffectMode mode) { return mode == ECHO_MODE || mode == LOOPER_MODE; }
+    static inline void pinConfig(void) { pinConfigEcho(); }
+    static inline void setup(void) { setupEcho(); }
+    static inline void loop(void) { loopEcho(); }
+    static inline void restart(EffectMode) { restartEcho(); }
+    static inline q15_t process(EffectMode mode, q15_t inputSample) {
+        return (mode == LOOPER_MODE) ? processLooperAudio(inputSample) : processEchoAudio(inputSample);
+    }
+    typedef EchoParams Params;
+    static constexpr uint8_t paramCount = ECHO_PARAM_COUNT;
+    static inline const ParamInfo *paramTable(void) { return echoParamTable; }
+    static inline void deriveParams(Params &params) { deriveEchoParams(params); }
+};
 
 #endif
@@ -0,0 +1,103 @@
+#ifndef EFFECTCHAIN_H
+#define EFFECTCHAIN_H
+#include "effects.h"
+
+/* Serial effect chain, rendered while CHAIN_MODE is active.
+ * Every stage is a regular EffectMode run through the ActiveEffects dispatch; stages
+ * hand their centered Q15 sample to the next one and the shared output stage in the
+ * ISR applies the master volume once at the end.
+ * A chain is only accepted if no two stages are served by the same effect, and if the
+ * declared worstCaseCycles of its stages, plus the per-stage dispatch and the fixed ISR
+ * cost, fit in one sample period. One effect's State holds one mode at a time (the echo
+ * line and the loop share bytes, the reverb's sub-modes reset their lines when the mode
+ * flips, the modulation modes share a line and LFO), so two stages of one effect, even
+ * the same mode twice, would corrupt it. The boot chain is checked at compile time,
+ * chains selected at runtime by effectChainSelect().*/
+#define EFFECT_CHAIN_MIN 2
+#define EFFECT_CHAIN_MAX 4
+
+/*Cycle budget. ISR_FIXED_CYCLES covers the ISR prologue/epilogue, ADC read and the
+ * output stage with its gain ramp (outputgain.h); compare it with the ISR_PROFILE report for NORMAL_MODE.
+ * Like the effects' worstCaseCycles it is an estimate until a simulator run sets it:
+ * tools/benchmark.py --apply writes the measured maxima into all of them.*/
+#define ISR_FIXED_CYCLES 120
+#define EFFECT_CHAIN_STAGE_CYCLES 20
+#define EFFECT_CHAIN_BUDGET_CYCLES (AUDIO_SAMPLE_PERIOD_CYCLES - ISR_FIXED_CYCLES)
+
+/*Chain loaded at boot*/
+#define EFFECT_CHAIN_DEFAULT {DISTORTION_MODE, ECHO_MODE}
+
+extern EffectMode effectChain[EFFECT_CHAIN_MAX];
+extern uint8_t effectChainLength;
+
+/**
+ * @brief: Worst-case cycles of a chain: declared kernel costs plus per-stage dispatch.
+ */
+constexpr uint32_t effectChainCycles(const EffectMode *modes, uint8_t count) {
+    return count == 0 ? 0 : ActiveEffects::cycles(modes[0]) + EFFECT_CHAIN_STAGE_CYCLES + effectChainCycles(modes + 1, count - 1);
+}
+
+/**
+ * @brief: True if every stage is an effect compiled into ActiveEffects (not CLEAN or CHAIN).
+ */
+constexpr bool effectChainStagesValid(const EffectMode *modes, uint8_t count) {
+    return count == 0 || (modes[0] != CLEAN_MODE && modes[0] != CHAIN_MODE && ActiveEffects::enabled(modes[0]) &&
+                          effectChainStagesValid(modes + 1, count - 1));
+}
+
+/**
+ * @brief: Effects used by a chain, one bit each (see EffectRegistry::effectMask()).
+ */
+constexpr uint8_t effectChainMask(const EffectMode *modes, uint8_t count) {
+    return count == 0 ? 0 : (uint8_t)(ActiveEffects::effectMask(modes[0]) | effectChainMask(modes + 1, count - 1));
+}
+
+/**
+ * @brief: True if no two stages are served by the same effect.
+ */
+constexpr bool effectChainStagesDistinct(const EffectMode *modes, uint8_t count) {
+    return count == 0 || ((ActiveEffects::effectMask(modes[0]) & effectChainMask(modes + 1, count - 1)) == 0 &&
+                          effectChainStagesDistinct(modes + 1, count - 1));
+}
+
+/*Result of a chain check, in the order the checks run*/
+enum EffectChainStatus {
+    EFFECT_CHAIN_OK = 0,
+    EFFECT_CHAIN_BAD_LENGTH,   // Fewer than EFFECT_CHAIN_MIN or more than EFFECT_CHAIN_MAX stages
+    EFFECT_CHAIN_BAD_STAGE,    // A stage is CLEAN, CHAIN or an effect not compiled in
+    EFFECT_CHAIN_SHARED,       // Two stages are served by the same effect
+    EFFECT_CHAIN_OVER_BUDGET   // The declared cycles do not fit EFFECT_CHAIN_BUDGET_CYCLES
+};
+
+/**
+ * @brief: Checks a chain's length, stages, effect use and cycle budget, in that order.
+ * @return The first check that fails, or EFFECT_CHAIN_OK.
+ */
+constexpr EffectChainStatus effectChainCheck(const EffectMode *modes, uint8_t count) {
+    return (count < EFFECT_CHAIN_MIN || count > EFFECT_CHAIN_MAX) ? EFFECT_CHAIN_BAD_LENGTH :
+           !effectChainStagesValid(modes, count) ? EFFECT_CHAIN_BAD_STAGE :
+           !effectChainStagesDistinct(modes, count) ? EFFECT_CHAIN_SHARED :
+           effectChainCycles(modes, count) > EFFECT_CHAIN_BUDGET_CYCLES ? EFFECT_CHAIN_OVER_BUDGET : EFFECT_CHAIN_OK;
+}
+
+/**
+ * @brief: True if the chain has a valid length and stages, uses every effect at most once
+ * and fits the ISR cycle budget.
+ */
+constexpr bool effectChainFits(const EffectMode *modes, uint8_t count) {
+    return effectChainCheck(modes, count) == EFFECT_CHAIN_OK;
+}
+
+/**
+ * @brief: True if every mode from mode up, alone, fits the ISR cycle budget of the sample rate (main.h).
+ */
+constexpr bool effectModesFit(uint8_t mode) {
+    return mode >= NUM_EFFECTS_ENUM ||
+           ((mode == CHAIN_MODE || ActiveEffects::cycles((EffectMode)mode) <= EFFECT_CHAIN_BUDGET_CYCLES) && effectModesFit(mode + 1));
+}
+
+extern q15_t processEffectChain(q15_t inputSample);
+extern void effectChainSetup(void);
+extern bool effectChainSelect(const EffectMode *modes, uint8_t count);
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef EFFECTS_H
+#define EFFECTS_H
+#include "main.h"
+#include "arena.h"
+#include "params.h"
+#include "reverb.h"
+#include "echo.h"
+#include "octaver.h"
+#include "distortion.h"
+#include "sinewave.h"
+#include "modulation.h"
+
+/* Compile-time effect registry.
+ * Every effect module declares a hook struct next to its functions:
+ *   struct State;                                    // its private SRAM, placed in the arena (arena.h)
+ *   static constexpr uint16_t worstCaseCycles;       // kernel cost estimate, for chain budgeting
+ *   static constexpr bool handles(EffectMode mode); // modes the effect serves
+ *   static void pinConfig(void);                     // once, from pinConfig()
+ *   static void setup(void);                         // once, from setup()
+ *   static void loop(void);                          // from loop() while one of its modes is active
+ *   static void restart(EffectMode mode);            // drops stale state before mode runs again after a
+ *                                                    // switch (transition.h); in the ISR, constant time
+ *   static q15_t process(EffectMode mode, q15_t inputSample); // audio kernel for one of its modes,
+ *                                                    // returns the sample before master volume
+ *   typedef ... Params;                              // its tunable settings (params.h)
+ *   static constexpr uint8_t paramCount;             // entries in its parameter table
+ *   static const ParamInfo *paramTable(void);        // the table, in flash
+ *   static void deriveParams(Params &params);        // recomputes derived values after a change
+ * EffectRegistry<...> expands these into straight-line code: the ISR dispatch becomes
+ * an if-chain of direct calls that the compiler can inline (the ISR is flattened),
+ * instead of a switch over out-of-line calls, around which the ISR has to save every
+ * call-clobbered register. tools/benchmark.py reports the ISR's push, pop and call
+ * counts and the flash size, to check that against a build. Effects left out of the
+ * list cost no code and their modes fall through to the clean pass-through.*/
+
+/*NORMAL mode lives in main.cpp*/
+struct NormalEffect {
+    struct State {};
+    static constexpr uint16_t worstCaseCycles = 10;
+    static constexpr bool handles(EffectMode mode) { return mode == NORMAL_MODE; }
+    static inline void pinConfig(void) {}
+    static inline void setup(void) {}
+    static inline void loop(void) {}
+    static inline void restart(EffectMode) {}
+    static inline q15_t process(EffectMode, q15_t inputSample) { return processNormalAudio(inputSample); }
+    typedef NoParams Params;
+    static constexpr uint8_t paramCount = 0;
+    static inline const ParamInfo *paramTable(void) { return nullptr; }
+    static inline void deriveParams(Params &) {}
+};
+
+template <typename... Effects> struct EffectRegistry;
+
+/*End of the list: CLEAN_MODE and any mode without a registered effect*/
+template <> struct EffectRegistry<> {
+    typedef EffectArenaLayout<> Arena;
+    typedef EffectParamLayout<> ParamLayout;
+    static constexpr uint8_t effectCount = 0;
+    static constexpr uint8_t totalParamCount = 0;
+    static constexpr bool enabled(EffectMode) { return false; }
+    static constexpr uint16_t cycles(EffectMode) { return 0; }
+    static constexpr uint8_t effectMask(EffectMode) { return 0; }
+    static inline void pinConfigAll(void) {}
+    static inline void setupAll(void) {}
+    static inline void paramsSetupAll(ParamLayout &) {}
+    static inline uint8_t params(uint8_t, const ParamInfo *&table) { table = nullptr; return 0; }
+    static inline uint8_t paramGet(ParamLayout &, uint8_t, uint8_t, uint16_t &) { return PARAM_UNKNOWN; }
+    static inline uint8_t paramSet(ParamLayout &, uint8_t, uint8_t, uint16_t) { return PARAM_UNKNOWN; }
+    static inline void loop(EffectMode) {}
+    static inline void restart(EffectMode) {}
+    static inline __attribute__((always_inline)) q15_t process(EffectMode, q15_t inputSample) {
+        return inputSample; // Simple pass-through
+    }
+    static inline void processBlock(EffectMode, const q15_t *in, q15_t *out, uint8_t count) {
+        for (uint8_t i = 0; i < count; i++) {
+            out[i] = in[i];
+        }
+    }
+};
+
+template <typename Effect, typename... Rest> struct EffectRegistry<Effect, Rest...> {
+    typedef EffectRegistry<Rest...> Next;
+    typedef EffectArenaLayout<Effect, Rest...> Arena; // State of every registered effect
+    typedef EffectParamLayout<Effect, Rest...> ParamLayout; // Parameter bank of every registered effect
+    static constexpr uint8_t effectCount = 1 + Next::effectCount;
+    static constexpr uint8_t totalParamCount = Effect::paramCount + Next::totalParamCount;
+
+    /*True when some registered effect serves mode. Usable in constant expressions.*/
+    static constexpr bool enabled(EffectMode mode) { return Effect::handles(mode) || Next::enabled(mode); }
+
+    /*Declared worst-case kernel cycles of the effect serving mode (0 for pass-through)*/
+    static constexpr uint16_t cycles(EffectMode mode) { return Effect::handles(mode) ? Effect::worstCaseCycles : Next::cycles(mode); }
+
+    /*Bit of the effect serving mode, by position in the list (0 for pass-through). Modes with a
+     * common bit share State and cannot run side by side.*/
+    static constexpr uint8_t effectMask(EffectMode mode) { return Effect::handles(mode) ? 1 : (uint8_t)(Next::effectMask(mode) << 1); }
+
+    static inline void pinConfigAll(void) {
+        Effect::pinConfig();
+        Next::pinConfigAll();
+    }
+
+    static inline void setupAll(void) {
+        Effect::setup();
+        Next::setupAll();
+    }
+
+    /*Loads every parameter with its table default, before setupAll()*/
+    static inline void paramsSetupAll(ParamLayout &layout) {
+        typename Effect::Params &next = layout.bank.stage();
+        for (uint8_t param = 0; param < Effect::paramCount; param++) {
+            ParamInfo info;
+            paramInfoRead(Effect::paramTable(), param, info);
+            paramWrite(&next, info, info.def);
+        }
+        Effect::deriveParams(next);
+        layout.bank.publish();
+        Next::paramsSetupAll(layout.rest);
+    }
+
+    /*Parameter table of an effect by its position in the list (the serial protocol's effect id)*/
+    static inline uint8_t params(uint8_t effect, const ParamInfo *&table) {
+        if (effect) return Next::params(effect - 1, table);
+        table = Effect::paramTable();
+        return Effect::paramCount;
+    }
+
+    /*Reads one parameter from the live block. Returns a ParamStatus.*/
+    static inline uint8_t paramGet(ParamLayout &layout, uint8_t effect, uint8_t param, uint16_t &value) {
+        if (effect) return Next::paramGet(layout.rest, effect - 1, param, value);
+        if (param >= Effect::paramCount) return PARAM_UNKNOWN;
+        ParamInfo info;
+        paramInfoRead(Effect::paramTable(), param, info);
+        value = paramRead(&layout.bank.live(), info);
+        return PARAM_OK;
+    }
+
+    /*Range-checks and publishes one parameter with its derived values. Returns a ParamStatus.*/
+    static inline uint8_t paramSet(ParamLayout &layout, uint8_t effect, uint8_t param, uint16_t value) {
+        if (effect) return Next::paramSet(layout.rest, effect - 1, param, value);
+        if (param >= Effect::paramCount) return PARAM_UNKNOWN;
+        ParamInfo info;
+        paramInfoRead(Effect::paramTable(), param, info);
+        if (!paramInRange(info, value)) return PARAM_OUT_OF_RANGE;
+        typename Effect::Params &next = layout.bank.stage();
+        paramWrite(&next, info, value);
+        Effect::deriveParams(next);
+        layout.bank.publish();
+        return PARAM_OK;
+    }
+
+    /*Runs the control-loop hook of the effect serving mode*/
+    static inline void loop(EffectMode mode) {
+        if (Effect::handles(mode)) {
+            Effect::loop();
+        } else {
+            Next::loop(mode);
+        }
+    }
+
+    /*Runs the restart hook of the effect serving mode*/
+    static inline void restart(EffectMode mode) {
+        if (Effect::handles(mode)) {
+            Effect::restart(mode);
+        } else {
+            Next::restart(mode);
+        }
+    }
+
+    /*Per-sample dispatch used by the ISR*/
+    static inline __attribute__((always_inline)) q15_t process(EffectMode mode, q15_t inputSample) {
+        if (Effect::handles(mode)) {
+            return Effect::process(mode, inputSample);
+        }
+        return Next::process(mode, inputSample);
+    }
+
+    /*Block dispatch: one decision per block, then a tight loop over the kernel*/
+    static inline void processBlock(EffectMode mode, const q15_t *in, q15_t *out, uint8_t count) {
+        if (Effect::handles(mode)) {
+            for (uint8_t i = 0; i < count; i++) {
+                out[i] = Effect::process(mode, in[i]);
+            }
+        } else {
+            Next::processBlock(mode, in, out, count);
+        }
+    }
+};
+
+/*Effects compiled into the pedal. Remove an entry to drop that effect from the build;
+ * its selection button is then ignored.*/
+typedef EffectRegistry<
+    NormalEffect,
+    OctaverEffect,
+    ReverbEffect,
+    EchoEffect,
+    DistortionEffect,
+    SinewaveEffect,
+    ModulationEffect
+> ActiveEffects;
+static_assert(ActiveEffects::effectCount <= 8, "EffectRegistry::effectMask() holds one bit per effect in a uint8_t");
+
+extern ActiveEffects::Arena effectArena;
+extern ActiveEffects::ParamLayout effectParamBanks;
+
+/**
+ * @brief: The arena slot owned by Effect. Resolves to a fixed address at compile time.
+ */
+template <typename Effect> static inline typename Effect::State &effectState(void) {
+    return EffectArenaLookup<Effect, ActiveEffects::Arena>::get(effectArena);
+}
+
+/**
+ * @brief: The parameter bank owned by Effect. Kernels read live(), loop() stages and publishes.
+ */
+template <typename Effect> static inline ParamBank<typename Effect::Params> &effectParams(void) {
+    return EffectParamLookup<Effect, ActiveEffects::ParamLayout>::get(effectParamBanks);
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+#include <stdint.h>
+
+/* Fixed-point DSP core shared by every effect kernel.
+ * The ATmega328P has no FPU, so all per-sample math is done on integers:
+ *  - q15_t  : audio samples and mix/feedback coefficients, signed, centered on 0,
+ *             -32768..32767 represents -1.0..+1.0.
+ *  - q7_8_t : gains above unity, 8 integer bits and 8 fractional bits.
+ * The ADC runs left adjusted (ADLAR = 1), so the 10-bit conversion already sits
+ * in the top bits of a 16-bit word and maps onto Q15 by flipping the sign bit.*/
+typedef int16_t q15_t;
+typedef int16_t q7_8_t;
+
+#define Q15_MAX ((q15_t)32767)
+#define Q15_MIN ((q15_t)-32768)
+
+/* Compile-time conversions for constants. Only ever use these with literals so
+ * the compiler folds them - never with runtime values inside the ISR.*/
+#define FLOAT_TO_Q15(x) ((q15_t)((x) >= 1.0 ? 32767 : ((x) < -1.0 ? -32768 : (x) * 32768.0 + ((x) >= 0 ? 0.5 : -0.5))))
+#define FLOAT_TO_Q7_8(x) ((q7_8_t)((x) * 256.0 + ((x) >= 0 ? 0.5 : -0.5)))
+/* Centered 10-bit units (-512..511, the scale the original float kernels used) to Q15*/
+#define SAMPLE10_TO_Q15(x) ((q15_t)((x) * 64))
+
+/**
+ * @brief: Clamps a 32-bit intermediate result into the Q15 range.
+ */
+static inline q15_t q15Saturate(int32_t x) {
+    if (x > Q15_MAX) return Q15_MAX;
+    if (x < Q15_MIN) return Q15_MIN;
+    return (q15_t)x;
+}
+
+/**
+ * @brief: Saturating Q15 addition.
+ */
+static inline q15_t q15Add(q15_t a, q15_t b) {
+    return q15Saturate((int32_t)a + b);
+}
+
+/**
+ * @brief: Saturating Q15 subtraction.
+ */
+static inline q15_t q15Sub(q15_t a, q15_t b) {
+    return q15Saturate((int32_t)a - b);
+}
+
+/**
+ * @brief: Q15 x Q15 multiply. Uses the hardware 8x8 multiplier through a single
+ * 16x16->32 product. The only overflowing case (-1.0 * -1.0) is saturated.
+ */
+static inline q15_t q15Mul(q15_t a, q15_t b) {
+    return q15Saturate(((int32_t)a * b) >> 15);
+}
+
+/**
+ * @brief: Crossfades between two Q15 signals: dry * (1 - amount) + wet * amount.
+ * Computed as dry + (wet - dry) * amount so only one multiply is needed.
+ * @param amount Wet proportion in Q15 (0 = all dry, Q15_MAX = all wet).
+ */
+static inline q15_t q15Mix(q15_t dry, q15_t wet, q15_t amount) {
+    return q15Saturate((int32_t)dry + ((((int32_t)wet - dry) * amount) >> 15));
+}
+
+/**
+ * @brief: Applies a Q7.8 gain (may exceed unity) to a Q15 sample with saturation.
+ */
+static inline q15_t q15Gain(q15_t x, q7_8_t gain) {
+    return q15Saturate(((int32_t)x * gain) >> 8);
+}
+
+/**
+ * @brief: Symmetrical hard limit of a Q15 sample to +/- limit.
+ */
+static inline q15_t q15Clip(q15_t x, q15_t limit) {
+    if (x > limit) return limit;
+    if (x < -limit) return -limit;
+    return x;
+}
+
+/**
+ * @brief: Converts the left-adjusted ADC result (ADCH:ADCL) to a centered Q15 sample.
+ */
+static inline q15_t q15FromAdc(uint8_t adcLow, uint8_t adcHigh) {
+    return (q15_t)((((uint16_t)adcHigh << 8) | adcLow) ^ 0x8000);
+}
+
+/**
+ * @brief: Packs a Q15 sample into unsigned 10-bit form (0-1023), the ADC/raw PCM scale.
+ */
+static inline uint16_t q15To10Bit(q15_t x) {
+    return ((uint16_t)x ^ 0x8000) >> 6;
+}
+
+/**
+ * @brief: Unpacks an unsigned 10-bit sample (0-1023) back to Q15.
+ */
+static inline q15_t q15From10Bit(uint16_t v) {
+    return (q15_t)((v << 6) ^ 0x8000);
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef INPUTS_H
+#define INPUTS_H
+#include "main.h"
+
+/* Event-driven front-panel inputs.
+ * inputsPoll() samples every switch with three port reads (PINB, PINC, PIND) instead of
+ * one digitalRead() per pin, and debounces each one: a new level is only accepted once
+ * it has been stable for DEBOUNCE_DELAY_MS. Accepted changes are queued as press/release
+ * events that loop() drains with inputsNextEvent(), so the mode logic only runs when
+ * something actually changed. All switches are active low (INPUT_PULLUP).
+ * Polling is used rather than pin-change interrupts: an extra ISR would delay the audio
+ * capture interrupt and contact bounce would fire it in bursts.*/
+
+/*Every switch on the pedal, in the order of inputPins (inputs.cpp)*/
+enum InputId {
+    INPUT_FOOTSWITCH = 0,
+    INPUT_TOGGLE,
+    INPUT_VOLUME_UP,
+    INPUT_VOLUME_DOWN,
+    INPUT_SELECT_OCTAVER,
+    INPUT_SELECT_NORMAL,
+    INPUT_SELECT_REVERB,
+    INPUT_SELECT_ECHO,
+    INPUT_SELECT_DISTORTION,
+    INPUT_SELECT_SINEWAVE,
+    INPUT_SELECT_CHAIN,
+    INPUT_SELECT_MODULATION,
+    INPUT_COUNT
+};
+
+enum InputEventType {
+    INPUT_PRESSED = 0, // Switch closed (pin pulled LOW)
+    INPUT_RELEASED
+};
+
+struct InputEvent {
+    InputId input;
+    InputEventType type;
+};
+
+extern void inputsSetup(void);
+extern void inputsPoll(void);
+extern bool inputsNextEvent(InputEvent &event);
+extern bool inputHeld(InputId input);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef ISRPROFILE_H
+#define ISRPROFILE_H
+#include "main.h"
+
+/* ISR cycle-budget instrumentation (enabled with ISR_PROFILE in main.h).
+ * Timer2 free-runs at ck/8 and is sampled on entry to and exit from the effect
+ * dispatch in TIMER1_CAPT_vect. One tick is 8 CPU cycles and the 8-bit counter wraps
+ * after 2048 cycles, four sample periods, so any ISR that has not already overrun
+ * several samples is measured correctly. The ISR prologue/epilogue pushes happen
+ * outside the measured window and are not included.
+ * Send 'p' over serial to print the report, 'r' to reset it (serialcommands.h).*/
+#define ISR_PROFILE_CYCLES_PER_TICK 8
+#define ISR_PROFILE_HIST_BINS 8
+#define ISR_PROFILE_HIST_SHIFT 5 // 32 ticks (256 cycles) per histogram bin
+
+struct IsrProfileStats {
+    uint8_t minTicks;
+    uint8_t maxTicks;
+    uint16_t overruns;                         // Next capture already pending at exit
+    uint32_t count;
+    uint32_t sumTicks;
+    uint16_t histogram[ISR_PROFILE_HIST_BINS]; // Saturates at 65535
+};
+
+#ifdef ISR_PROFILE
+extern IsrProfileStats isrProfileStats[NUM_EFFECTS_ENUM];
+
+/**
+ * @brief: Accounts one ISR pass to the mode that handled it.
+ * @param mode The effect mode that was dispatched.
+ * @param ticks Elapsed Timer2 ticks between entry and exit.
+ */
+static inline void isrProfileRecord(EffectMode mode, uint8_t ticks) {
+    IsrProfileStats *stats = &isrProfileStats[mode];
+    if (ticks < stats->minTicks) stats->minTicks = ticks;
+    if (ticks > stats->maxTicks) stats->maxTicks = ticks;
+    stats->count++;
+    stats->sumTicks += ticks;
+    uint16_t *bin = &stats->histogram[ticks >> ISR_PROFILE_HIST_SHIFT];
+    if (*bin != 0xFFFF) (*bin)++;
+    if (TIFR1 & _BV(ICF1)) stats->overruns++;
+}
+
+#define ISR_PROFILE_ENTER() uint8_t isrProfileStart = TCNT2
+#define ISR_PROFILE_EXIT(mode) isrProfileRecord((mode), (uint8_t)(TCNT2 - isrProfileStart))
+
+extern void isrProfileSetup(void);
+extern void isrProfileReset(void);
+extern void isrProfilePrint(void);
+#else
+#define ISR_PROFILE_ENTER()
+#define ISR_PROFILE_EXIT(mode)
+#endif
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef LFO_H
+#define LFO_H
+#include "main.h"
+
+/* Low-frequency oscillator shared by the modulation effects.
+ * The waveform is only evaluated at the control rate, once every 2^LFO_DECIMATION_LOG2
+ * samples; in between, lfoTick() ramps linearly toward the next point, so the modulation
+ * has no zipper steps and costs one add per sample. Each effect owns its Lfo in its
+ * arena State. Sine points come from the DDS table in flash (sinewave.h).*/
+#define LFO_DECIMATION_LOG2 5 // Control rate: every 32 samples, ~980 Hz
+#define LFO_CONTROL_RATE_HZ (AUDIO_SAMPLE_RATE_HZ / (1 << LFO_DECIMATION_LOG2))
+/*16-bit phase step of a constant rate in Hz, folded at compile time. ~0.015 Hz resolution.*/
+#define LFO_STEP(hz) ((uint16_t)((hz) * 65536.0 / LFO_CONTROL_RATE_HZ + 0.5))
+/*Phase step per 0.01 Hz in Q16, for rates set at runtime: step = (centiHz * this + 0x8000) >> 16*/
+#define LFO_STEP_PER_CENTIHERTZ_Q16 ((uint32_t)(65536.0 * 65536.0 / (LFO_CONTROL_RATE_HZ * 100.0) + 0.5))
+
+enum LfoShape {
+    LFO_SINE = 0,
+    LFO_TRIANGLE
+};
+
+struct Lfo {
+    uint16_t phase;
+    uint16_t step;      // Phase advance per control-rate update
+    q15_t value;        // Current output, -1.0..+1.0
+    q15_t increment;    // Per-sample ramp toward the next control point
+    uint8_t countdown;  // Samples left until the next control point
+    uint8_t shape;      // LfoShape
+};
+
+extern void lfoStart(Lfo &lfo, LfoShape shape, uint16_t step);
+extern void lfoAdvance(Lfo &lfo);
+
+/**
+ * @brief: Advances the LFO by one audio sample and returns its value (Q15, bipolar).
+ * Every 2^LFO_DECIMATION_LOG2 calls it also computes the next control point.
+ */
+static inline q15_t lfoTick(Lfo &lfo) {
+    if (--lfo.countdown == 0) {
+        lfoAdvance(lfo);
+    }
+    lfo.value += lfo.increment;
+    return lfo.value;
+}
+
+/**
+ * @brief: Maps the bipolar LFO value to 0..Q15_MAX, for gains and delay offsets.
+ */
+static inline q15_t lfoUnipolar(q15_t value) {
+    return (q15_t)((value >> 1) + 0x4000);
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef LOOPER_H
+#define LOOPER_H
+#include "main.h"
+#include "adpcm.h"
+
+/* LOOPER_MODE: record, overdub and playback of one loop, kept as 4-bit ADPCM (adpcm.h).
+ * The loop is stored at 1/LOOPER_DECIMATION of the sample rate: each stored sample is the
+ * mean of LOOPER_DECIMATION input samples, and playback interpolates linearly between
+ * stored samples. Every LOOPER_DECIMATION samples the ISR decodes the stored sample at
+ * the loop position, adds the input when recording or overdubbing, and encodes the result
+ * back in its place; the other samples only sum and interpolate. Every slot is re-encoded
+ * on every pass, so the codec stays in step wherever an overdub starts or stops, and both
+ * coders restart from silence where the loop wraps.
+ * The loop shares the echo line's arena bytes (ECHO_MODE and LOOPER_MODE are one effect,
+ * see echo.h, which sets LOOPER_CODE_BYTES and includes this file): LOOPER_CODE_BYTES hold
+ * 2 * LOOPER_CODE_BYTES stored samples, 157 ms at the default rate and decimation, less
+ * when the echo line gives way to an optional module. LOOPER_DECIMATION_LOG2 3 doubles
+ * that at half the bandwidth.
+ * Selecting the mode starts the first take (see below); looperPress() closes it, then toggles overdub,
+ * a press in the first LOOPER_MIN_MS of the take is ignored rather than closing a loop of a few slots;
+ * looperRecordAgain() drops the loop and records a new first take. Leaving the mode
+ * pauses the loop where it is; coming back resumes it, unless ECHO_MODE has used the bytes
+ * in between or the switch came from a mode sharing the echo effect (transition.h).*/
+#define LOOPER_DECIMATION_LOG2 2 // Stored at 7.8 kHz at the default rate: 3.9 kHz bandwidth
+#define LOOPER_DECIMATION (1 << LOOPER_DECIMATION_LOG2)
+#ifndef LOOPER_CODE_BYTES
+#error "Include echo.h, which sizes the loop to the echo line"
+#endif
+#define LOOPER_SLOTS (2 * LOOPER_CODE_BYTES) // Stored samples: two codes per byte
+#define LOOPER_MAX_MS (LOOPER_SLOTS * LOOPER_DECIMATION * 1000.0 / AUDIO_SAMPLE_RATE_HZ)
+#define LOOPER_MIN_MS 25 // Shortest first take a press closes
+#define LOOPER_MIN_SLOTS ((uint16_t)(LOOPER_MIN_MS * AUDIO_SAMPLE_RATE_HZ / (1000.0 * LOOPER_DECIMATION)))
+
+/*Kernel cycles: one decode and one encode per stored sample, plus summing, packing and interpolation*/
+#define LOOPER_CYCLES (ADPCM_DECODE_CYCLES + ADPCM_ENCODE_CYCLES + 80)
+
+enum LooperPhase {
+    LOOPER_RECORDING = 0, // First take: sets the loop length
+    LOOPER_PLAYING,
+    LOOPER_OVERDUBBING    // Input added to the loop as it plays
+};
+
+enum LooperRequest {
+    LOOPER_REQUEST_NONE = 0,
+    LOOPER_REQUEST_PRESS,        // Close the first take, or toggle overdub
+    LOOPER_REQUEST_RECORD_AGAIN  // Drop the loop and record a new first take
+};
+
+/*Loop memory and playback state. Lives in the echo effect's arena State*/
+struct Looper {
+    uint8_t codes[LOOPER_CODE_BYTES]; // Slot n in the low (even n) or high (odd n) nibble of byte n / 2
+    AdpcmState encoder;               // Writes this pass's codes
+    AdpcmState decoder;               // Reads the codes of the pass before
+    uint16_t position;                // Slot the next stored sample goes to
+    uint16_t length;                  // Loop length in slots, 0 during the first take
+    q15_t sum;                        // Input summed since the last slot, pre-divided by LOOPER_DECIMATION
+    q15_t previous;                   // Stored samples playback interpolates between
+    q15_t current;
+    uint8_t subSample;                // Samples since the last slot, 0 to LOOPER_DECIMATION - 1
+    uint8_t phase;                    // LooperPhase
+};
+
+extern void restartLooper(void);
+extern q15_t processLooperAudio(q15_t inputSample);
+extern void looperPress(void);
+extern void looperRecordAgain(void);
+extern void looperCancelRequest(void);
+
+#endif
@@ -2,19 +2,15 @@
 #define MAIN_H
 #include <Arduino.h>
 #include <TimerOne.h> 
+#include "fixedpoint.h"
+#include "delayline.h"
 
-/*Effects selectable through buttons A3 - A6*/
-#define NORMAL
-#define OCTAVER
-#define REVERB
-#define ECHO
-#define DISTORTION
-#define SINEWAVE 
+/*Effects compiled into the pedal are listed in ActiveEffects (effects.h)*/
 
 /*Hardware interface resource definitions*/
 #define LED_EFFECT_ON 13
 #define FOOTSWITCH 12 // Global Momentary Bypass: Press (LOW) for CLEAN_MODE, Release (HIGH) for last selected effect
-#define TOGGLE 11  // Reverb sub-mode toggle switch: HIGH for REVERB_ECHO_MODE, LOW for DELAY_MODE
+#define TOGGLE 11  // Reverb sub-mode toggle switch: HIGH for REVERB_ECHO_MODE, LOW for DELAY_MODE; flipped in LOOPER_MODE, records a new loop
 
 /*Audio input/output pin definitions*/
 #define AUDIO_IN A0 // Audio input pin
@@ -28,28 +24,103 @@
 #define SELECT_OCTAVER_BUTTON A3 // OCTAVER_MODE
 #define SELECT_NORMAL_BUTTON A4 // NORMAL_MODE
 #define SELECT_REVERB_BUTTON A5 // REVERB_ECHO_MODE 
-#define SELECT_ECHO_BUTTON 2 // ECHO_MODE 
+#define SELECT_ECHO_BUTTON 2 // ECHO_MODE, press again for LOOPER_MODE, then to close the loop and toggle overdub
 #define SELECT_DISTORTION_BUTTON 3 // DISTORTION_MODE
 #define SELECT_SINEWAVE_BUTTON 4 // SINEWAVE_MODE 
+#define SELECT_CHAIN_BUTTON 5 // CHAIN_MODE
+#define SELECT_MODULATION_BUTTON 6 // CHORUS_MODE, press again for FLANGER, VIBRATO, TREMOLO
+
+/*Sample rate: the single setting that paces the pedal. AUDIO_RATE picks the Timer1 PWM
+ * setup whose capture event starts each conversion and ISR; the sample period, the ADC
+ * prescaler, the split over the two PWM outputs and every time or frequency constant of
+ * the effects (sine and LFO steps, delay times in microseconds, fades) derive from it at
+ * compile time. A faster rate leaves fewer cycles per sample: an effect whose worst case
+ * no longer fits fails to compile (see effectchain.h).
+ *  - AUDIO_RATE_15K: fast PWM, TOP 1023: 15625 Hz, 1024 cycles per sample, 10-bit PWM
+ *  - AUDIO_RATE_31K: phase and frequency correct PWM, TOP 255: 31372.5 Hz, 510 cycles, 8-bit PWM
+ *  - AUDIO_RATE_62K: fast PWM, TOP 255: 62500 Hz, 256 cycles, 8-bit PWM*/
+#define AUDIO_RATE_15K 0
+#define AUDIO_RATE_31K 1
+#define AUDIO_RATE_62K 2
+#ifndef AUDIO_RATE
+#define AUDIO_RATE AUDIO_RATE_31K
+#endif
+
+#if AUDIO_RATE == AUDIO_RATE_15K
+#define PWM_MODE 1  // Fast PWM
+#define PWM_BITS 10
+#elif AUDIO_RATE == AUDIO_RATE_31K
+#define PWM_MODE 0  // Phase and frequency correct PWM
+#define PWM_BITS 8
+#elif AUDIO_RATE == AUDIO_RATE_62K
+#define PWM_MODE 1
+#define PWM_BITS 8
+#else
+#error "AUDIO_RATE must be AUDIO_RATE_15K, AUDIO_RATE_31K or AUDIO_RATE_62K"
+#endif
 
 /*PWM parameters definition*/
-#define PWM_FREQ 0x00FF // PWM frequency - 31.3KHz
-#define PWM_MODE 0      // Phase Correct (0) or Fast (1) PWM
+#define PWM_FREQ ((1U << PWM_BITS) - 1) // Timer1 TOP (ICR1)
 #define PWM_QTY 2       // 2 PWMs in parallel for higher resolution
-
-/*Effect buffer size. Maximum value - 500*/
-#define MAX_DELAY 350
+/*Timer1 clocks per sample: phase correct PWM counts up and down, fast PWM only up*/
+#define AUDIO_SAMPLE_PERIOD_CYCLES (PWM_MODE ? (PWM_FREQ + 1UL) : (2UL * PWM_FREQ))
+#define AUDIO_SAMPLE_RATE_HZ ((double)F_CPU / AUDIO_SAMPLE_PERIOD_CYCLES) // For compile-time constants only
+
+/*ADC clock: the slowest prescaler (log2, as ADPS2:0) whose auto-triggered conversion, 13.5
+ * ADC clocks, ends within a sample period. At 15.6 and 31.4 kHz the ADC clock stays near its
+ * 200 kHz full-accuracy limit (250 and 500 kHz); at 62.5 kHz it runs at 1 MHz and loses bits*/
+#define ADC_CONVERSION_CLOCKS 14 // 13.5, rounded up
+#define ADC_PRESCALER_LOG2 (AUDIO_SAMPLE_PERIOD_CYCLES >= 128UL * ADC_CONVERSION_CLOCKS ? 7 : \
+                            AUDIO_SAMPLE_PERIOD_CYCLES >= 64UL * ADC_CONVERSION_CLOCKS ? 6 : \
+                            AUDIO_SAMPLE_PERIOD_CYCLES >= 32UL * ADC_CONVERSION_CLOCKS ? 5 : \
+                            AUDIO_SAMPLE_PERIOD_CYCLES >= 16UL * ADC_CONVERSION_CLOCKS ? 4 : 3)
+
+/*ISR cycle profiling. Uncomment ISR_PROFILE to time the effect dispatch with Timer2
+ * and print a per-mode report on serial command 'p' (see isrprofile.h)*/
+// #define ISR_PROFILE
+
+/*Serial console speed. 500 kbaud is exact at 16 MHz (U2X, UBRR0 = 3) and keeps prints short*/
+#define SERIAL_BAUD 500000UL
+
+/*Sample capture telemetry. Uncomment TELEMETRY to let the ISR queue input/output samples,
+ * mode changes and overruns that loop() streams as binary frames over Serial; serial
+ * commands 'c' and 't' start a capture (see telemetry.h, tools/telemetry_decode.py)*/
+// #define TELEMETRY
+
+/*Block-based processing. Uncomment AUDIO_BLOCK_MODE to let the ISR only move samples
+ * through ping-pong buffers of AUDIO_BLOCK_SIZE samples while the effects run once per block.
+ * Adds 2 * AUDIO_BLOCK_SIZE samples of latency (see audioblock.h)*/
+// #define AUDIO_BLOCK_MODE
+#define AUDIO_BLOCK_SIZE 16
+
+/*Effect switching. A mode change crossfades the outgoing into the incoming effect over
+ * TRANSITION_FADE_MS (see transition.h). Uncomment TRANSITION_TAILS to let the outgoing
+ * effect's delay or reverb tail ring out for TRANSITION_TAIL_MS under the new one*/
+#define TRANSITION_FADE_MS 20
+// #define TRANSITION_TAILS
+#define TRANSITION_TAIL_MS 800
+
+/*Sample I/O backend (see sampleio.h). Left unset, the AVR build uses SAMPLE_IO_TIMER1_PWM
+ * and the host build SAMPLE_IO_BUFFER*/
+// #define SAMPLE_IO_BACKEND SAMPLE_IO_STREAM
+
+/*Simulator benchmark. BENCHMARK (set by the bench environment in platformio.ini) replaces the
+ * switches with a walk through every mode and tags each ISR with the mode it renders, for
+ * tools/benchmark.py to time under simavr (see benchmark.h)*/
+// #define BENCHMARK
+
+/*Delay time in microseconds to samples, rounded, and the other way round for constants.
+ * DELAY_US_TO_SAMPLES has a 32-bit multiply: use it in a deriveParams() hook (params.h),
+ * not per sample. Times up to 65535 us.*/
+#define DELAY_SAMPLES_PER_US_Q16 ((uint32_t)(AUDIO_SAMPLE_RATE_HZ * 65536.0 / 1000000.0 + 0.5))
+#define DELAY_US_TO_SAMPLES(us) ((uint16_t)(((uint32_t)(us) * DELAY_SAMPLES_PER_US_Q16 + 0x8000) >> 16))
+#define DELAY_SAMPLES_TO_US(samples) ((uint16_t)((samples) * 1000000.0 / AUDIO_SAMPLE_RATE_HZ + 0.5))
 
 /*General variables*/
-extern int input_raw_sample; // Will hold the raw 10-bit ADC value (0-1023)
-extern uint8_t ADC_low, ADC_high; // For direct ADC read in ISR
+extern q15_t input_raw_sample; // Will hold the centered Q15 input sample (sampleio.h)
 
-extern uint16_t delayBuffer[MAX_DELAY]; // Buffer for delay-based effects
-extern uint32_t delayWritePointer;      // Current write position in delayBuffer
-extern uint32_t delayReadOffset;        // Calculated read offset (used in effect processing)
-extern uint32_t delayDepth;             // Not explicitly used in current logic, can be removed if unused
 
-extern volatile int pot2_value; // Master Volume, now controlled by PUSHBUTTON_1/2 globally
+extern int pot2_value; // Master Volume (0-1024), controlled by PUSHBUTTON_1/2 globally; loop() only, the ISR uses outputgain.h
 
 // Enum for universal effect mode management
 enum EffectMode {
@@ -61,30 +132,21 @@ enum EffectMode {
     OCTAVER_MODE,           // Octaver effect
     DISTORTION_MODE,        // Distortion effect
     SINEWAVE_MODE,          // Sinewave generator
+    CHORUS_MODE,            // Chorus (MODULATION module)
+    FLANGER_MODE,           // Flanger (MODULATION module)
+    VIBRATO_MODE,           // Vibrato (MODULATION module)
+    TREMOLO_MODE,           // Tremolo (MODULATION module)
+    CHAIN_MODE,             // Serial chain of effects (see effectchain.h)
+    LOOPER_MODE,            // Record/overdub/playback looper (sub-mode of ECHO module, see looper.h)
     NUM_EFFECTS_ENUM        // Helper to count total modes (always last)
 };
 
 extern volatile bool effectActive; // Global ON/OFF state (true if any effect is running, false for clean bypass)
 extern volatile EffectMode lastSelectedMode; // Stores the last selected effect mode (not CLEAN_MODE)
 
-/* Debouncing Variables*/
-extern volatile unsigned long lastFootswitchPressTime;
-extern volatile unsigned long lastToggleSwitchStateChange; // Used by Reverb sub-mode
+/* Debouncing (see inputs.h)*/
 extern const unsigned long DEBOUNCE_DELAY_MS;
-extern volatile unsigned long lastPushButton1PressTime;
-extern volatile unsigned long lastPushButton2PressTime;
-
-// Debouncing for effect selection buttons (A1, A2, A3)
-extern volatile unsigned long lastSelectNormalPressTime;
-extern volatile unsigned long lastSelectEffectButtonA2PressTime;
-extern volatile unsigned long lastSelectOctaverPressTime;
-
-/*Counter to periodically check pushbuttons (saves CPU in ISR) - now just for NORMAL's legacy volume*/
-extern volatile int button_check_counter;
-extern const int BUTTON_CHECK_INTERVAL; // Check buttons every 100 samples
-
-/* Configure audio parameters - Consistent 20kHz sample rate */
-extern const long SAMPLE_RATE_MICROS;
+extern const unsigned long VOLUME_REPEAT_MS;
 
 
 extern volatile EffectMode currentActiveMode; // Universal variable for the currently active effect mode
@@ -95,14 +157,20 @@ extern void adcSetup();
 extern void pinConfig ();
 extern void pmwSetup(void);
 extern void volumeControl();
+extern void setMasterVolume(int volume);
+extern bool selectEffectMode(EffectMode mode);
+
+/*Effect dispatch shared by the per-sample ISR path and the block pipeline*/
+extern q15_t processAudioSample(EffectMode mode, q15_t inputSample);
+extern void processAudioBlock(EffectMode mode, const q15_t *in, q15_t *out, uint8_t count);
 
 /* Audio processing functions for each effect (called by the universal ISR)
- * All processXAudio functions now accept 'int inputSample' for consistency,
- * even if a generator doesn't use it*/
-extern void processNormalAudio(int inputSample);
-extern void processReverbAudio(int inputSample);
-extern void processEchoAudio(int inputSample);
-extern void processOctaverAudio(int inputSample);
-extern void processDistortionAudio(int inputSample);
-extern void processSinewaveAudio(int inputSample); 
+ * All processXAudio functions accept a centered Q15 'inputSample' for consistency,
+ * even if a generator doesn't use it, and return the processed sample before master volume*/
+extern q15_t processNormalAudio(q15_t inputSample);
+extern q15_t processReverbAudio(q15_t inputSample, EffectMode mode);
+extern q15_t processEchoAudio(q15_t inputSample);
+extern q15_t processOctaverAudio(q15_t inputSample);
+extern q15_t processDistortionAudio(q15_t inputSample);
+extern q15_t processSinewaveAudio(q15_t inputSample); 
 #endif
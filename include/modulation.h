@@ -0,0 +1,60 @@
+#ifndef MODULATION_H
+#define MODULATION_H
+#include "main.h"
+#include "lfo.h"
+#include "params.h"
+
+/* Modulation effects built on the shared LFO (lfo.h) and interpolated delay reads:
+ *  - CHORUS_MODE  : slow sine sweep of a ~5 ms delay, mixed with the dry signal.
+ *  - FLANGER_MODE : triangle sweep of a 0.25-3 ms delay with feedback.
+ *  - VIBRATO_MODE : faster sine sweep of a short delay, wet only (pitch wobble).
+ *  - TREMOLO_MODE : sine amplitude modulation, no delay line.
+ * Only one of them runs at a time, so they share one delay line and LFO; both are
+ * restarted when the mode changes. Rates, depths and mixes are parameters (modulation.cpp).*/
+#define MODULATION_DELAY_BITS 10
+#define MODULATION_DELAY_SIZE_LOG2 8 // 256 samples (~8 ms) in 320 bytes of the arena
+
+/*Tunable settings (see params.h and the table in modulation.cpp).
+ * The per-mode arrays are indexed by mode - CHORUS_MODE.*/
+#define MODULATION_MODES 4
+struct ModulationParams {
+    uint16_t rate[MODULATION_MODES];    // LFO rate in 0.01 Hz steps
+    q15_t depth[MODULATION_MODES];      // Share of the mode's widest sweep; gain swing for tremolo
+    q15_t mix;                          // CHORUS_MODE and FLANGER_MODE wet/dry balance
+    q15_t feedback;                     // FLANGER_MODE feedback
+    uint16_t lfoStep[MODULATION_MODES]; // Derived: rate as an LFO phase step
+    uint16_t sweep[MODULATION_MODES];   // Derived: depth in 8.8 samples (unused by tremolo)
+};
+#define MODULATION_PARAM_COUNT (2 * MODULATION_MODES + 2)
+extern const ParamInfo modulationParamTable[MODULATION_PARAM_COUNT]; // In flash (PROGMEM)
+
+extern void pinConfigModulation(void);
+extern void setupModulation(void);
+extern void loopModulation(void);
+extern void restartModulation(void);
+extern q15_t processModulationAudio(q15_t inputSample, EffectMode mode);
+extern void deriveModulationParams(ModulationParams &params);
+
+/*Effect registry hooks (see effects.h)*/
+struct ModulationEffect {
+    struct State {
+        DelayLine<MODULATION_DELAY_BITS, MODULATION_DELAY_SIZE_LOG2> delay;
+        Lfo lfo;
+        uint8_t runningMode; // Mode the line and LFO are set up for, CLEAN_MODE after restart()
+    };
+    static constexpr uint16_t worstCaseCycles = 200;
+    static constexpr bool handles(EffectMode mode) {
+        return mode == CHORUS_MODE || mode == FLANGER_MODE || mode == VIBRATO_MODE || mode == TREMOLO_MODE;
+    }
+    static inline void pinConfig(void) { pinConfigModulation(); }
+    static inline void setup(void) { setupModulation(); }
+    static inline void loop(void) { loopModulation(); }
+    static inline void restart(EffectMode) { restartModulation(); }
+    static inline q15_t process(EffectMode mode, q15_t inputSample) { return processModulationAudio(inputSample, mode); }
+    typedef ModulationParams Params;
+    static constexpr uint8_t paramCount = MODULATION_PARAM_COUNT;
+    static inline const ParamInfo *paramTable(void) { return modulationParamTable; }
+    static inline void deriveParams(Params &params) { deriveModulationParams(params); }
+};
+
+#endif
@@ -1,10 +1,53 @@
 #ifndef OCTAVER_H
 #define OCTAVER_H
 #include "main.h"
+#include "params.h"
+
+/* Analog-style octaver, integer only:
+ *  - Octave down: a low-passed copy of the input drives a zero-crossing detector with
+ *    hysteresis; every rising crossing toggles a flip-flop, and the flip-flop gates the
+ *    input's polarity, giving a signal at half the input's fundamental.
+ *  - Octave up: full-wave rectification (|x|) doubles the fundamental; a one-pole
+ *    DC-removal filter takes out the offset rectification adds.
+ * The three signals are mixed with the weights in OctaverParams.
+ * Works best on single notes, like the pedals it imitates.*/
+#define OCTAVER_HYSTERESIS SAMPLE10_TO_Q15(8) // Detector must swing past +/- this to count a crossing
+#define OCTAVER_DETECT_SHIFT 3                // Detector low-pass: y += (x - y) >> 3, ~670 Hz corner
+#define OCTAVER_DC_SHIFT 8                    // DC removal: ~20 Hz corner
+
+/*Tunable settings (see params.h and the table in octaver.cpp)*/
+struct OctaverParams {
+    q15_t dry; // Mix weights of the dry, octave-down and octave-up signals
+    q15_t sub;
+    q15_t up;
+};
+#define OCTAVER_PARAM_COUNT 3
+extern const ParamInfo octaverParamTable[OCTAVER_PARAM_COUNT]; // In flash (PROGMEM)
 
 extern void pinConfigOctaver(void);
 extern void setupOctaver(void);
 extern void loopOctaver(void);
-extern void processOctaverAudio(int inputSample); 
+extern q15_t processOctaverAudio(q15_t inputSample);
+
+/*Effect registry hooks (see effects.h)*/
+struct OctaverEffect {
+    struct State {
+        q15_t detector;   // Low-passed input seen by the zero-crossing detector
+        int32_t dcLevel;  // Rectified signal average, scaled by 2^OCTAVER_DC_SHIFT
+        bool positive;    // Detector half-cycle, switched with hysteresis
+        bool subPolarity; // Flip-flop output: polarity applied to the octave-down signal
+    };
+    static constexpr uint16_t worstCaseCycles = 90;
+    static constexpr bool handles(EffectMode mode) { return mode == OCTAVER_MODE; }
+    static inline void pinConfig(void) { pinConfigOctaver(); }
+    static inline void setup(void) { setupOctaver(); }
+    static inline void loop(void) { loopOctaver(); }
+    static inline void restart(EffectMode) {}
+    static inline q15_t process(EffectMode, q15_t inputSample) { return processOctaverAudio(inputSample); }
+    typedef OctaverParams Params;
+    static constexpr uint8_t paramCount = OCTAVER_PARAM_COUNT;
+    static inline const ParamInfo *paramTable(void) { return octaverParamTable; }
+    static inline void deriveParams(Params &) {}
+};
 
 #endif
@@ -0,0 +1,46 @@
+#ifndef OUTPUTGAIN_H
+#define OUTPUTGAIN_H
+#include "main.h"
+
+/* Master volume, applied once per sample at the output.
+ * The volume setting (pot2_value, 0-1024 button steps) maps to a Q15 gain through a
+ * log-taper table in flash: OUTPUT_GAIN_RANGE_DB of range, with 0 as mute. The lower half of
+ * the settings climbs to -OUTPUT_GAIN_MID_DB at 512 and the upper half on to unity, each in
+ * equal dB steps, so the boot volume (512) plays at 0.25 as the original double 512/1024
+ * scaling did. Below the range the 10-bit PWM output is at its noise floor anyway. loop() looks the
+ * gain up when the volume changes and sets it as the target. The ISR moves the gain it uses
+ * toward the target by at most OUTPUT_GAIN_RAMP_STEP per sample, so button steps and preset
+ * loads glide instead of stepping (no zipper noise). A full 0 to 1.0 sweep takes
+ * 32768 / OUTPUT_GAIN_RAMP_STEP samples (~260 ms).*/
+#define OUTPUT_GAIN_TABLE_POINTS 65 // One point every 16 volume steps
+#define OUTPUT_GAIN_VOLUME_SHIFT 4  // log2 of the volume steps per point
+#define OUTPUT_GAIN_RANGE_DB 48
+#define OUTPUT_GAIN_MID_DB 12       // Attenuation at volume 512, the boot default
+#define OUTPUT_GAIN_RAMP_STEP 4
+
+extern const q15_t outputGainTable[OUTPUT_GAIN_TABLE_POINTS]; // In flash (PROGMEM)
+
+extern volatile q15_t outputGainTarget; // Written by loop() with interrupts off
+extern q15_t outputGainCurrent;         // Ramped by the ISR only
+
+extern void outputGainSetVolume(int volume, bool immediate);
+
+/**
+ * @brief: Output gain stage. Steps the gain one ramp step toward the target and
+ * applies it to sample. Called once per sample, in the ISR only.
+ */
+static inline q15_t outputGainApply(q15_t sample) {
+    q15_t gain = outputGainCurrent;
+    q15_t target = outputGainTarget;
+    if (gain != target) {
+        if (gain < target) {
+            gain = (target - gain > OUTPUT_GAIN_RAMP_STEP) ? gain + OUTPUT_GAIN_RAMP_STEP : target;
+        } else {
+            gain = (gain - target > OUTPUT_GAIN_RAMP_STEP) ? gain - OUTPUT_GAIN_RAMP_STEP : target;
+        }
+        outputGainCurrent = gain;
+    }
+    return q15Mul(sample, gain);
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef PARAMS_H
+#define PARAMS_H
+#include <stdint.h>
+#include <stddef.h>
+
+/* Runtime-tunable effect parameters.
+ * Every effect keeps its musical settings in a 'Params' struct and describes them in a
+ * parameter table in flash: one ParamInfo per setting with its name, type, range and
+ * default, and the offset of the value inside Params. Params may also hold derived
+ * values (delay offsets, phase steps) that the effect's deriveParams() hook recomputes
+ * whenever a setting changes, so the kernels never redo that math per sample.
+ *
+ * The ISR reads a ParamBank's live() block; loop() prepares a change in the other block
+ * (stage() copies the live settings into it), derives, and publish() flips the one-byte
+ * index. The ISR only ever sees a complete block: old or new, never half of a 16 or
+ * 32-bit value. loop() is the only writer, and it never runs while an ISR is using the
+ * live block, so the staged block is always free.
+ * Banks of the effects in ActiveEffects are laid out like the arena (arena.h), in
+ * effectParamBanks, and must fit PARAM_BANK_BYTES (checked in params.cpp).*/
+#define PARAM_NAME_CHARS 12 // Including the terminating NUL
+#define PARAM_BANK_BYTES 224
+
+/*How the 16-bit value of a parameter is interpreted and range-checked*/
+enum ParamType {
+    PARAM_U8 = 0, // uint8_t field
+    PARAM_U16,    // uint16_t field
+    PARAM_Q15,    // q15_t field, signed range
+    PARAM_Q7_8    // q7_8_t field, signed range
+};
+
+/*One parameter table entry, stored in flash (PROGMEM)*/
+struct ParamInfo {
+    char name[PARAM_NAME_CHARS];
+    uint8_t type;   // ParamType
+    uint8_t offset; // Position of the value in the effect's Params
+    uint16_t min;   // Range and default as raw 16-bit values
+    uint16_t max;
+    uint16_t def;
+};
+
+#define PARAM_ENTRY(name, type, Params, field, min, max, def) \
+    {name, type, (uint8_t)offsetof(Params, field), (uint16_t)(min), (uint16_t)(max), (uint16_t)(def)}
+
+/*Result of a parameter access*/
+enum ParamStatus {
+    PARAM_OK = 0,
+    PARAM_UNKNOWN,      // No such effect or parameter
+    PARAM_OUT_OF_RANGE, // Value outside the table range, nothing changed
+    PARAM_BAD_FRAME,    // Serial request failed its checksum
+    PARAM_BUSY          // The EEPROM is still writing a preset, retry later
+};
+
+/*Double-buffered parameter block (see above)*/
+template <typename Params> class ParamBank {
+public:
+    /*Block in use by the ISR*/
+    inline const Params &live(void) const { return bank[active]; }
+
+    /*Spare block, loaded with the live settings, for loop() to modify*/
+    inline Params &stage(void) {
+        Params &next = bank[active ^ 1];
+        next = bank[active];
+        return next;
+    }
+
+    /*Hands the staged block to the ISR: a single byte store*/
+    inline void publish(void) { active ^= 1; }
+
+private:
+    Params bank[2];
+    volatile uint8_t active;
+};
+
+/*Effect without settings*/
+struct NoParams {};
+
+/*Parameter banks of a list of effects, in registry order*/
+template <typename... Effects> struct EffectParamLayout;
+
+template <> struct EffectParamLayout<> {};
+
+template <typename First, typename... Rest> struct EffectParamLayout<First, Rest...> {
+    ParamBank<typename First::Params> bank;
+    EffectParamLayout<Rest...> rest;
+};
+
+/*Finds an effect's bank inside a layout at compile time*/
+template <typename Effect, typename Layout> struct EffectParamLookup;
+
+template <typename Effect, typename... Rest> struct EffectParamLookup<Effect, EffectParamLayout<Effect, Rest...> > {
+    static inline ParamBank<typename Effect::Params> &get(EffectParamLayout<Effect, Rest...> &layout) { return layout.bank; }
+};
+
+template <typename Effect, typename First, typename... Rest> struct EffectParamLookup<Effect, EffectParamLayout<First, Rest...> > {
+    static inline ParamBank<typename Effect::Params> &get(EffectParamLayout<First, Rest...> &layout) {
+        return EffectParamLookup<Effect, EffectParamLayout<Rest...> >::get(layout.rest);
+    }
+};
+
+/*Effect not registered: see EffectArenaLookup*/
+template <typename Effect> struct EffectParamLookup<Effect, EffectParamLayout<> > {
+    static inline ParamBank<typename Effect::Params> &get(EffectParamLayout<> &) {
+        static ParamBank<typename Effect::Params> unused;
+        return unused;
+    }
+};
+
+extern void paramInfoRead(const ParamInfo *table, uint8_t param, ParamInfo &info);
+extern bool paramInRange(const ParamInfo &info, uint16_t value);
+extern uint16_t paramRead(const void *params, const ParamInfo &info);
+extern void paramWrite(void *params, const ParamInfo &info, uint16_t value);
+
+#endif
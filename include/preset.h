@@ -0,0 +1,30 @@
+#ifndef PRESET_H
+#define PRESET_H
+#include "main.h"
+
+/* Preset store in the ATmega328P's 1 KB EEPROM.
+ * A record holds the selected mode, the master volume and every effect parameter in
+ * parameter table order (params.h), after a slot byte and a sequence number, and ends with
+ * a CRC-16 over all of it. A layout signature (a CRC of the parameter tables) keeps records
+ * written by firmware with other tables from being applied.
+ *  - PRESET_USER_SLOTS fixed records at the start hold user presets, written only on
+ *    request (serial 'W' / 'L', serialcommands.h).
+ *  - The rest is a ring for the last-used state. Each save goes to the slot after the
+ *    newest record, so wear spreads evenly over the ring; a save cut short by a power
+ *    loss fails its CRC and the previous record stays in force.
+ * loop() takes a CRC of the live state every PRESET_CHECK_MS and saves it once it differs
+ * from the saved one and has then held still for PRESET_SETTLE_MS. A save writes one byte
+ * per loop() pass, whenever the EEPROM is ready (~3.4 ms per byte), so loop() never waits
+ * and the ISR never touches the EEPROM.
+ * presetSetup() restores the newest valid ring record at boot: it reads each ring record
+ * once to check it, then the winner once more to apply it, a few ms in all.*/
+#define PRESET_USER_SLOTS 4
+#define PRESET_CHECK_MS 250
+#define PRESET_SETTLE_MS 3000
+
+extern bool presetSetup(void);
+extern void presetService(void);
+extern uint8_t presetSave(uint8_t preset);
+extern uint8_t presetLoad(uint8_t preset);
+
+#endif
@@ -1,10 +1,107 @@
 #ifndef REVERB_H
 #define REVERB_H
 #include "main.h"
+#include "params.h"
+
+/* REVERB_ECHO_MODE: Schroeder/Freeverb style network. REVERB_COMBS parallel feedback
+ * combs with a one-pole damping filter in the loop, summed and diffused by
+ * REVERB_ALLPASSES series all-pass filters. Lengths are mutually prime (reverb.cpp) so
+ * the comb resonances do not line up. Comb lines keep 10 bits (see delayline.h): the
+ * tail recirculates through them, so 8 bits would truncate it away within ~15 ms, and
+ * each comb carries its rounding error into its next write so 10 bits decay like the
+ * float network (reverb.cpp).
+ * The network runs at 1 / REVERB_DECIMATION of the sample rate (~3.9 kHz at 31.4 kHz):
+ * the same 64-entry comb lines then hold 12-16 ms instead of 2 ms, long enough for a
+ * room rather than a metallic ring, and the tail is band-limited like a damped room
+ * anyway. Each sample adds the input to a block average and runs one filter of the
+ * network, round robin (combs, then all-passes, then the block end), so the ISR pays for
+ * one filter per sample, not all of them. The wet output is ramped linearly from one
+ * block's result to the next. The filter count must leave the block end a slot of its
+ * own (checked in reverb.cpp).*/
+#define REVERB_COMBS 3     // 1 to 4 parallel combs
+#define REVERB_ALLPASSES 2 // 1 to 2 series all-pass filters
+#define REVERB_DECIMATION_LOG2 3
+#define REVERB_DECIMATION (1 << REVERB_DECIMATION_LOG2)
+#define REVERB_COMB_BITS 10
+#define REVERB_COMB_SIZE_LOG2 6    // 64 network samples (~16 ms)
+#define REVERB_ALLPASS_BITS 8
+#define REVERB_ALLPASS_SIZE_LOG2 4 // 16 network samples (~4 ms)
+
+/*Estimated kernel cycles of one sample slot. A comb slot reads and writes a packed 10-bit
+ * line and does three multiplies (damping, feedback, error feedback); the block end
+ * scales the input and wet sums and sets the next ramp; the mix runs every sample
+ * (input average, ramp, dry/wet blend). Check against tools/benchmark.py.*/
+#define REVERB_COMB_CYCLES 220
+#define REVERB_ALLPASS_CYCLES 100
+#define REVERB_BLOCK_CYCLES 80
+#define REVERB_MIX_CYCLES 70
+
+/*DELAY_MODE line (see delayline.h): 10-bit x 2^8 = 256 samples (~8 ms at 31.4 kHz)*/
+#define REVERB_DELAY_BITS 10
+#define REVERB_DELAY_SIZE_LOG2 8
+#define REVERB_DELAY_MAX_US DELAY_SAMPLES_TO_US((1 << REVERB_DELAY_SIZE_LOG2) - 1)
+
+/*Tunable settings (see params.h and the table in reverb.cpp)*/
+struct ReverbParams {
+    q15_t roomSize;        // REVERB_ECHO_MODE comb feedback: decay of the tail
+    q15_t damping;         // REVERB_ECHO_MODE high-frequency loss per pass
+    q15_t mix;             // REVERB_ECHO_MODE wet/dry balance
+    uint16_t time;         // DELAY_MODE delay time in microseconds
+    q15_t feedback;        // DELAY_MODE share of each repeat fed back
+    uint16_t delaySamples; // Derived: time in samples at the sample rate
+};
+#define REVERB_PARAM_COUNT 5
+extern const ParamInfo reverbParamTable[REVERB_PARAM_COUNT]; // In flash (PROGMEM)
 
 extern void pinConfigReverb(void);
 extern void setUpReverb(void);
 extern void loopReverb(void);
-extern void processReverbAudio(int inputSample); 
+extern void restartReverb(void);
+extern q15_t processReverbAudio(q15_t inputSample, EffectMode mode);
+extern void deriveReverbParams(ReverbParams &params);
+
+/*One damped feedback comb*/
+struct ReverbComb {
+    DelayLine<REVERB_COMB_BITS, REVERB_COMB_SIZE_LOG2> line;
+    q15_t damped; // Low-passed comb output fed back into the line
+};
+
+/*REVERB_ECHO_MODE lines and the decimation around them*/
+struct ReverbNetwork {
+    ReverbComb comb[REVERB_COMBS];
+    DelayLine<REVERB_ALLPASS_BITS, REVERB_ALLPASS_SIZE_LOG2> allpass[REVERB_ALLPASSES];
+    int32_t combSum;                   // Comb outputs of the running block
+    int16_t inputSum;                  // Input of the running block, each sample / REVERB_DECIMATION
+    q15_t blockInput;                  // Scaled input of the previous block, fed to the combs
+    q15_t wet;                         // Output of the last all-pass
+    q15_t ramp;                        // Wet output, ramped toward the newest block's
+    q15_t rampStep;                    // Per-sample change of ramp
+    int8_t combResidual[REVERB_COMBS]; // Rounding error carried to each comb's next write (reverb.cpp)
+    uint8_t slot;                      // Sample of the block, picks the filter that runs
+};
+
+/*Effect registry hooks (see effects.h)*/
+struct ReverbEffect {
+    struct State {
+        /*Only one sub-mode runs at a time, so its lines share the same arena bytes*/
+        union {
+            ReverbNetwork network;                                      // REVERB_ECHO_MODE
+            DelayLine<REVERB_DELAY_BITS, REVERB_DELAY_SIZE_LOG2> delay; // DELAY_MODE
+        } lines;
+        uint8_t linesMode; // Sub-mode the lines currently hold, CLEAN_MODE after restart()
+    };
+    /*One filter per sample, the heaviest being a comb (checked in reverb.cpp), plus the mix*/
+    static constexpr uint16_t worstCaseCycles = REVERB_MIX_CYCLES + REVERB_COMB_CYCLES;
+    static constexpr bool handles(EffectMode mode) { return mode == REVERB_ECHO_MODE || mode == DELAY_MODE; }
+    static inline void pinConfig(void) { pinConfigReverb(); }
+    static inline void setup(void) { setUpReverb(); }
+    static inline void loop(void) { loopReverb(); }
+    static inline void restart(EffectMode) { restartReverb(); }
+    static inline q15_t process(EffectMode mode, q15_t inputSample) { return processReverbAudio(inputSample, mode); }
+    typedef ReverbParams Params;
+    static constexpr uint8_t paramCount = REVERB_PARAM_COUNT;
+    static inline const ParamInfo *paramTable(void) { return reverbParamTable; }
+    static inline void deriveParams(Params &params) { deriveReverbParams(params); }
+};
 
 #endif
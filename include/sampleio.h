@@ -0,0 +1,114 @@
+#ifndef SAMPLEIO_H
+#define SAMPLEIO_H
+#include "main.h"
+
+/* Sample input/output backend.
+ * TIMER1_CAPT_vect reads one centered Q15 sample per period with sampleIoRead() and
+ * writes one with sampleIoWrite(); everything in between (effects, transitions, output
+ * gain) only ever sees centered samples. SAMPLE_IO_BACKEND picks the backend at compile
+ * time; all of them are inlined into the ISR:
+ *  - SAMPLE_IO_TIMER1_PWM: ADC0 result, left adjusted, in; Timer1 dual PWM out, the top
+ *    PWM_BITS on OCR1A and the rest on OCR1B, scaled to its 1/256 weight in the output
+ *    mixer (at 8 bits simply the high and low bytes). The default on the AVR.
+ *  - SAMPLE_IO_BUFFER: arrays bound with sampleIoBufferBind(), one sample per ISR call.
+ *    Input is cut to 10 bits like the ADC's, so renders match the pedal. The default on
+ *    the host (host renderer, unit tests).
+ *  - SAMPLE_IO_STREAM: raw little-endian 10-bit words (0-1023) read from and written to
+ *    stdio streams bound with sampleIoStreamBind(). Host only; sampleIoStreamEnded turns
+ *    true at the end of the input, and from then on silence is read and nothing written.
+ * The conversions are XORs, shifts and masks: no branches, the same cycles for any sample.*/
+#define SAMPLE_IO_TIMER1_PWM 1
+#define SAMPLE_IO_BUFFER 2
+#define SAMPLE_IO_STREAM 3
+
+#ifndef SAMPLE_IO_BACKEND
+#if defined(__AVR__)
+#define SAMPLE_IO_BACKEND SAMPLE_IO_TIMER1_PWM
+#else
+#define SAMPLE_IO_BACKEND SAMPLE_IO_BUFFER
+#endif
+#endif
+
+#define SAMPLE_IO_ADC_MASK ((q15_t)0xFFC0) // The 10 bits a left-adjusted conversion delivers
+
+#if SAMPLE_IO_BACKEND == SAMPLE_IO_TIMER1_PWM
+/**
+ * @brief: Reads the conversion Timer1's capture event started. Low byte first.
+ */
+static inline q15_t sampleIoRead(void) {
+    uint8_t low = ADCL;
+    uint8_t high = ADCH;
+    return q15FromAdc(low, high);
+}
+
+/**
+ * @brief: Splits the sample over the two PWM outputs, re-biased to unsigned.
+ */
+static inline void sampleIoWrite(q15_t sample) {
+#if PWM_BITS == 8
+    OCR1AL = ((uint16_t)sample ^ 0x8000) >> 8; // High byte
+    OCR1BL = (uint8_t)sample;                  // Low byte
+#else
+    uint16_t level = (uint16_t)sample ^ 0x8000;
+    OCR1A = level >> (16 - PWM_BITS);
+    OCR1B = (level & ((1U << (16 - PWM_BITS)) - 1)) << (PWM_BITS - 8);
+#endif
+}
+
+#elif SAMPLE_IO_BACKEND == SAMPLE_IO_BUFFER
+/*In-memory sample buffers: in[position] is read, then out[position] written*/
+struct SampleIoBuffer {
+    const q15_t *in;
+    q15_t *out;
+    uint16_t position;
+};
+extern SampleIoBuffer sampleIoBuffer;
+
+static inline void sampleIoBufferBind(const q15_t *in, q15_t *out) {
+    sampleIoBuffer.in = in;
+    sampleIoBuffer.out = out;
+    sampleIoBuffer.position = 0;
+}
+
+static inline q15_t sampleIoRead(void) {
+    return sampleIoBuffer.in[sampleIoBuffer.position] & SAMPLE_IO_ADC_MASK;
+}
+
+static inline void sampleIoWrite(q15_t sample) {
+    sampleIoBuffer.out[sampleIoBuffer.position++] = sample;
+}
+
+#elif SAMPLE_IO_BACKEND == SAMPLE_IO_STREAM
+#include <stdio.h>
+extern FILE *sampleIoStreamIn;
+extern FILE *sampleIoStreamOut;
+extern bool sampleIoStreamEnded;
+
+static inline void sampleIoStreamBind(FILE *in, FILE *out) {
+    sampleIoStreamIn = in;
+    sampleIoStreamOut = out;
+    sampleIoStreamEnded = false;
+}
+
+static inline q15_t sampleIoRead(void) {
+    int low = getc(sampleIoStreamIn);
+    int high = getc(sampleIoStreamIn);
+    if (high == EOF) {
+        sampleIoStreamEnded = true;
+        return 0;
+    }
+    return q15From10Bit((uint16_t)((high << 8) | low) & 0x3FF);
+}
+
+static inline void sampleIoWrite(q15_t sample) {
+    if (sampleIoStreamEnded) return;
+    uint16_t code = q15To10Bit(sample);
+    putc(code & 0xFF, sampleIoStreamOut);
+    putc(code >> 8, sampleIoStreamOut);
+}
+
+#else
+#error "SAMPLE_IO_BACKEND must be SAMPLE_IO_TIMER1_PWM, SAMPLE_IO_BUFFER or SAMPLE_IO_STREAM"
+#endif
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef SERIALCOMMANDS_H
+#define SERIALCOMMANDS_H
+#include "main.h"
+
+/* Serial console, handled in one place for every module.
+ * Single-byte commands:
+ *   'p' print the ISR cycle report, 'r' reset it           (ISR_PROFILE, isrprofile.h)
+ *   'c' capture from the next sample, 't' capture on level (TELEMETRY, telemetry.h)
+ * Commands of modules that are not compiled in are ignored.
+ *
+ * Binary parameter protocol (params.h), driven by tools/pedal_params.py. Request, 7 bytes:
+ *   PARAM_SYNC, command, effect, param, value (uint16 LE), checksum (8-bit sum of command..value)
+ * Reply:
+ *   PARAM_SYNC, command, status (ParamStatus), effect, param, length, payload, checksum
+ *   (8-bit sum of command..payload)
+ * Commands:
+ *   'N' list      payload: effect count, then the parameter count of each effect
+ *   'D' describe  payload: type, min, max, default (uint16 LE), name (PARAM_NAME_CHARS)
+ *   'G' get       payload: live value (uint16 LE)
+ *   'S' set       payload: live value after the request (uint16 LE)
+ *   'W' save      the live state as user preset 'effect' (1..PRESET_USER_SLOTS, preset.h)
+ *   'L' load      user preset 'effect'; no payload for either
+ * The effect id is the position in ActiveEffects. A request whose bytes stop arriving
+ * for SERIAL_FRAME_TIMEOUT_MS is dropped, so a lost byte cannot swallow later commands.*/
+#define PARAM_SYNC 0xA6
+#define PARAM_REQUEST_BYTES 7
+#define SERIAL_FRAME_TIMEOUT_MS 50
+
+extern void serialCommandsPoll(void);
+
+#endif
@@ -1,11 +1,60 @@
 #ifndef SINEWAVE_H
 #define SINEWAVE_H
 #include "main.h"
+#include "params.h"
+
+/* Integer DDS generator with SINE_VOICES simultaneous voices (chords, test tones).
+ * Each voice has a 32-bit phase accumulator advanced by a 32-bit step per sample
+ * (derived from its frequency parameter when that changes):
+ * the top 8 bits index sineTable (in flash) and the next 8 bits interpolate to the
+ * following entry. Every voice is computed on every sample, silent or not, so the
+ * cost is fixed by SINE_VOICES alone.
+ * step = frequency * 2^32 / sample rate, i.e. a resolution of ~7 uHz at 31.4 kHz.*/
+#define SINE_TABLE_SIZE 256
+#define SINE_VOICES 4
+#define SINE_VOICE_CYCLES 60 // Estimated cost of one voice, for worstCaseCycles
+
+/*Phase step of a constant frequency in Hz. Only use with constants, it is folded at compile time.*/
+#define SINE_STEP(hz) ((uint32_t)((hz) * 4294967296.0 / AUDIO_SAMPLE_RATE_HZ + 0.5))
+/*Phase step per 0.1 Hz, for frequencies set at runtime (deriveSinewaveParams). Rounding
+ * it to an integer detunes by at most 40 ppm (0.07 cents).*/
+#define SINE_STEP_PER_DECIHERTZ SINE_STEP(0.1)
+
+extern const q15_t sineTable[SINE_TABLE_SIZE + 1]; // In flash (PROGMEM), last entry repeats the first
+
+/*Tunable settings (see params.h and the table in sinewave.cpp)*/
+struct SinewaveParams {
+    uint16_t frequency[SINE_VOICES]; // 0.1 Hz steps (4400 = 440 Hz), up to 6553.5 Hz
+    q15_t level[SINE_VOICES];        // 0 mutes the voice
+    uint32_t step[SINE_VOICES];      // Derived: phase advance per sample
+};
+#define SINEWAVE_PARAM_COUNT (2 * SINE_VOICES)
+extern const ParamInfo sinewaveParamTable[SINEWAVE_PARAM_COUNT]; // In flash (PROGMEM)
 
-extern void createSineTable(void);
 extern void pinConfigSinewave(void);
 extern void setupSinewave(void);
 extern void loopSinewave(void);
-extern void processSinewaveAudio(int inputSample); 
+extern void restartSinewave(void);
+extern q15_t processSinewaveAudio(q15_t inputSample);
+extern void sinewaveSetVoice(uint8_t voice, uint16_t frequencyDeciHz, q15_t level);
+extern void deriveSinewaveParams(SinewaveParams &params);
+
+/*Effect registry hooks (see effects.h)*/
+struct SinewaveEffect {
+    struct State {
+        uint32_t phase[SINE_VOICES];
+    };
+    static constexpr uint16_t worstCaseCycles = 20 + SINE_VOICES * SINE_VOICE_CYCLES;
+    static constexpr bool handles(EffectMode mode) { return mode == SINEWAVE_MODE; }
+    static inline void pinConfig(void) { pinConfigSinewave(); }
+    static inline void setup(void) { setupSinewave(); }
+    static inline void loop(void) { loopSinewave(); }
+    static inline void restart(EffectMode) { restartSinewave(); }
+    static inline q15_t process(EffectMode, q15_t inputSample) { return processSinewaveAudio(inputSample); }
+    typedef SinewaveParams Params;
+    static constexpr uint8_t paramCount = SINEWAVE_PARAM_COUNT;
+    static inline const ParamInfo *paramTable(void) { return sinewaveParamTable; }
+    static inline void deriveParams(Params &params) { deriveSinewaveParams(params); }
+};
 
 #endif
@@ -0,0 +1,131 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+#include "main.h"
+
+/* Sample capture and event telemetry (enabled with TELEMETRY in main.h).
+ * The audio ISR is the single producer of a lock-free ring of compact records and
+ * loop() is the single consumer: each side owns one 8-bit index (head / tail), so a
+ * push is a few loads and stores with no cli() and a full ring drops the record and
+ * counts it instead of blocking. Records:
+ *  - TELEMETRY_SAMPLE  input and output sample, every TELEMETRY_DECIMATION-th sample
+ *                      for TELEMETRY_CAPTURE_SAMPLES records after a trigger.
+ *  - TELEMETRY_TRIGGER a capture started: the input sample and the decimation.
+ *  - TELEMETRY_MODE    the ISR dispatched a different mode than on the previous sample.
+ *  - TELEMETRY_OVERRUN the next capture was already pending at exit: mode and running count.
+ *  - TELEMETRY_DROPPED records lost to a full ring since the last report (sent by loop()).
+ * A capture starts at once (serial 'c') or on the first input sample whose magnitude
+ * reaches TELEMETRY_TRIGGER_LEVEL (serial 't'); there is no room for pre-trigger history.
+ *
+ * telemetryService() writes whole frames to Serial only while its interrupt-driven
+ * transmit buffer has room, so loop() never waits on the UART. Frame, 7 bytes:
+ *   TELEMETRY_SYNC, type, a (int16 LE), b (int16 LE), checksum (8-bit sum of type..b)
+ * Console text shares the port; the decoder (tools/telemetry_decode.py) skips anything
+ * that is not a valid frame. Full-rate capture is out of reach: 31.4 k frames/s would
+ * need 2.2 Mbaud and one transmit interrupt every ~70 cycles. At the default decimation
+ * of 8, captures run at ~3.9 kHz and use about half of SERIAL_BAUD.*/
+#define TELEMETRY_RING_SIZE_LOG2 4 // 16 records, 80 bytes
+#define TELEMETRY_RING_SIZE (1 << TELEMETRY_RING_SIZE_LOG2)
+#define TELEMETRY_RING_MASK (TELEMETRY_RING_SIZE - 1)
+#define TELEMETRY_DECIMATION 8
+#define TELEMETRY_CAPTURE_SAMPLES 2048 // ~0.5 s at the decimated rate
+#define TELEMETRY_TRIGGER_LEVEL SAMPLE10_TO_Q15(64)
+#define TELEMETRY_SYNC 0xA5
+#define TELEMETRY_FRAME_BYTES 7
+
+enum TelemetryRecordType {
+    TELEMETRY_SAMPLE = 'S',
+    TELEMETRY_TRIGGER = 'T',
+    TELEMETRY_MODE = 'M',
+    TELEMETRY_OVERRUN = 'O',
+    TELEMETRY_DROPPED = 'D'
+};
+
+struct TelemetryRecord {
+    uint8_t type;
+    int16_t a;
+    int16_t b;
+};
+
+struct TelemetryRing {
+    TelemetryRecord records[TELEMETRY_RING_SIZE];
+    volatile uint8_t head;     // Next slot the ISR fills, written by the ISR only
+    volatile uint8_t tail;     // Next slot loop() sends, written by loop() only
+    volatile uint16_t dropped; // Records lost to a full ring, cleared when reported
+};
+
+/*ISR-side capture state*/
+struct TelemetryCapture {
+    uint16_t remaining;  // Sample records left in the running capture, 0 when idle
+    uint8_t countdown;   // Samples until the next sample record
+    bool armed;          // Waiting for the trigger
+    q15_t triggerLevel;  // Input magnitude that starts the capture, 0 for the next sample
+    uint8_t lastMode;    // Mode of the previous sample
+    uint16_t overruns;   // Running count, sent with every overrun record
+};
+
+#ifdef TELEMETRY
+extern TelemetryRing telemetryRing;
+extern TelemetryCapture telemetryCapture;
+
+/**
+ * @brief: Producer side of the ring, ISR only. The record is written before the head
+ * index that publishes it; a full ring drops the record.
+ */
+static inline void telemetryPush(uint8_t type, int16_t a, int16_t b) {
+    uint8_t head = telemetryRing.head;
+    uint8_t next = (head + 1) & TELEMETRY_RING_MASK;
+    if (next == telemetryRing.tail) {
+        if (telemetryRing.dropped != 0xFFFF) telemetryRing.dropped++;
+        return;
+    }
+    TelemetryRecord *record = &telemetryRing.records[head];
+    record->type = type;
+    record->a = a;
+    record->b = b;
+    __asm__ __volatile__("" ::: "memory"); // Record stores must not move past the publish
+    telemetryRing.head = next;
+}
+
+/**
+ * @brief: Per-sample hook called by the ISR after the output sample is written.
+ * @param mode The effect mode that was dispatched.
+ * @param inputSample The sample fed to the effects.
+ * @param outputSample The sample written to the PWM, master volume applied.
+ */
+static inline void telemetryRecord(EffectMode mode, q15_t inputSample, q15_t outputSample) {
+    TelemetryCapture *capture = &telemetryCapture;
+    if (mode != capture->lastMode) {
+        capture->lastMode = mode;
+        telemetryPush(TELEMETRY_MODE, mode, 0);
+    }
+    if (capture->remaining) {
+        if (--capture->countdown == 0) {
+            capture->countdown = TELEMETRY_DECIMATION;
+            capture->remaining--;
+            telemetryPush(TELEMETRY_SAMPLE, inputSample, outputSample);
+        }
+    } else if (capture->armed && (inputSample >= capture->triggerLevel || inputSample <= -capture->triggerLevel)) {
+        capture->armed = false;
+        capture->remaining = TELEMETRY_CAPTURE_SAMPLES;
+        telemetryPush(TELEMETRY_TRIGGER, inputSample, TELEMETRY_DECIMATION);
+        // The triggering sample is the first one captured
+        capture->countdown = TELEMETRY_DECIMATION;
+        capture->remaining--;
+        telemetryPush(TELEMETRY_SAMPLE, inputSample, outputSample);
+    }
+    if (TIFR1 & _BV(ICF1)) {
+        capture->overruns++;
+        telemetryPush(TELEMETRY_OVERRUN, mode, capture->overruns);
+    }
+}
+
+#define TELEMETRY_RECORD(mode, inputSample, outputSample) telemetryRecord((mode), (inputSample), (outputSample))
+
+extern void telemetrySetup(void);
+extern void telemetryStartCapture(bool onLevel);
+extern void telemetryService(void);
+#else
+#define TELEMETRY_RECORD(mode, inputSample, outputSample)
+#endif
+
+#endif
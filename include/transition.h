@@ -0,0 +1,69 @@
+#ifndef TRANSITION_H
+#define TRANSITION_H
+#include "main.h"
+
+/* Click-free mode switching.
+ * loop() never switches currentActiveMode on its own: transitionTo() starts a transition
+ * and the ISR renders it, so the output never jumps and tails are not cut off.
+ *  - Crossfade: the outgoing and incoming modes both run for TRANSITION_FADE_SAMPLES and
+ *    the output moves from one to the other with an integer ramp. With TRANSITION_TAILS
+ *    only the outgoing effect's input is faded; its output then keeps ringing, fed with
+ *    silence, and fades out over TRANSITION_TAIL_SAMPLES under the incoming mode.
+ *  - Dip: the outgoing mode fades to silence over half the window, then the incoming one
+ *    fades in over the other half. Used when the two modes share an effect (one State
+ *    cannot run two modes at once, e.g. the reverb's sub-modes or the modulation effects),
+ *    or when running both would not fit the ISR cycle budget.
+ *  - Cut: an immediate switch, only if even a dip does not fit (a chain at the edge of
+ *    the budget).
+ * The budget check adds the declared worstCaseCycles of both modes (effects.h; chains
+ * through effectChainCycles()) and TRANSITION_MIX_CYCLES, against the same budget as a
+ * chain. When the two modes share an effect, its restart() runs on the first sample of the
+ * incoming mode, so that starts from silence rather than from what the outgoing mode left.
+ * Effects not shared keep their lines: switching back to one resumes its tail.
+ * A request made during a transition waits for the crossfade or dip to finish (a
+ * ringing tail is faded out over TRANSITION_FADE_SAMPLES first).*/
+#define TRANSITION_FADE_SAMPLES ((uint16_t)(TRANSITION_FADE_MS * AUDIO_SAMPLE_RATE_HZ / 1000.0 + 0.5))
+#define TRANSITION_TAIL_SAMPLES ((uint16_t)(TRANSITION_TAIL_MS * AUDIO_SAMPLE_RATE_HZ / 1000.0 + 0.5))
+#define TRANSITION_MIX_CYCLES 40 // Ramp, mix multiplies and phase logic, on top of both modes
+
+enum TransitionPhase {
+    TRANSITION_IDLE = 0,  // Only currentActiveMode runs
+    TRANSITION_CROSSFADE, // Both modes run, fade is the incoming level
+    TRANSITION_TAIL,      // Incoming at full level, fade is the level of the ringing outgoing mode
+    TRANSITION_DIP_OUT,   // Outgoing mode alone, fade is its level
+    TRANSITION_DIP_IN     // Incoming mode alone, fade is its level
+};
+
+struct Transition {
+    EffectMode from;     // Outgoing mode
+    uint16_t remaining;  // Samples left in this phase
+    q15_t fade;
+    q15_t step;          // Per-sample change of fade
+    uint8_t phase;       // TransitionPhase
+    bool restartPending; // Restart the incoming mode's effects on its first sample (dip with a shared effect)
+    bool tail;           // Outgoing mode rings out after the crossfade (TRANSITION_TAILS)
+};
+
+extern Transition transition; // Written by loop() with interrupts off, advanced by the ISR
+
+extern void transitionSetup(EffectMode mode);
+extern void transitionTo(EffectMode mode);
+extern EffectMode transitionTarget(void);
+extern void transitionService(void);
+extern q15_t transitionRun(EffectMode mode, q15_t inputSample);
+
+/**
+ * @brief: Runs one sample through mode, blended with the outgoing mode while a transition
+ * is in progress. Used by the ISR in place of processAudioSample().
+ * @param mode The incoming (current) mode.
+ * @param inputSample The centered Q15 input audio sample.
+ * @return The processed Q15 sample, before master volume.
+ */
+static inline q15_t transitionProcess(EffectMode mode, q15_t inputSample) {
+    if (transition.phase == TRANSITION_IDLE) {
+        return processAudioSample(mode, inputSample);
+    }
+    return transitionRun(mode, inputSample);
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+/* Host shim for the parts of the Arduino core and AVR register set used by the pedal.
+ * Only compiled into [env:native]; the AVR registers become plain globals. Samples
+ * normally bypass them through the host backends of sampleio.h; a build with
+ * SAMPLE_IO_BACKEND=SAMPLE_IO_TIMER1_PWM has the host renderer (native/src/host_main.cpp)
+ * write the ADC and read the PWM registers around each ISR call instead.*/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define PI 3.1415926535897932384626433832795
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+/*Flash access: on the host PROGMEM data is ordinary memory*/
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define memcpy_P memcpy
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+/*Interrupt vectors become plain functions the host renderer can call*/
+#define ISR(vector, ...) extern "C" void vector(void) __VA_ARGS__; void vector(void)
+static inline void sei(void) {}
+static inline void cli(void) {}
+
+/*AVR I/O registers used by the firmware*/
+extern volatile uint8_t ADCL, ADCH, ADMUX, ADCSRA, ADCSRB, DIDR0;
+extern volatile uint8_t TCCR1A, TCCR1B, TIMSK1, ICR1H, ICR1L, OCR1AL, OCR1BL;
+extern volatile uint16_t OCR1A, OCR1B; // 16-bit access, PWM_BITS above 8
+extern volatile uint8_t DDRB, SREG, TIFR1;
+extern volatile uint8_t TCCR2A, TCCR2B, TCNT2;
+extern volatile uint8_t PINB, PINC, PIND; // Read as all high: every switch open (pullups)
+
+#define _BV(bit) (1 << (bit))
+#define ICF1 5
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t val);
+unsigned long millis(void);
+unsigned long micros(void);
+/*Moves millis() and micros() ahead, so host tests need not wait out timeouts (host builds only)*/
+void hostAdvanceMillis(unsigned long ms);
+
+/*Serial output goes to stderr so stdout stays free for streamed audio. Input comes from
+ * bytes queued with serialHostInput() (host builds only), none by default.*/
+class HardwareSerial {
+public:
+    void begin(unsigned long baud);
+    int available(void);
+    int read(void);
+    int availableForWrite(void);
+    size_t write(uint8_t c);
+    size_t print(const char *s);
+    size_t print(const __FlashStringHelper *s);
+    size_t print(char c);
+    size_t print(int n);
+    size_t print(unsigned int n);
+    size_t print(long n);
+    size_t print(unsigned long n);
+    size_t print(double n);
+    size_t println(void);
+    template <typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+};
+extern HardwareSerial Serial;
+void serialHostInput(const uint8_t *data, size_t length);
+
+#endif
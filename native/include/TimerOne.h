@@ -0,0 +1,4 @@
+#ifndef NATIVE_TIMERONE_H
+#define NATIVE_TIMERONE_H
+/* Host shim: main.h includes TimerOne.h but the firmware drives Timer1 directly.*/
+#endif
@@ -0,0 +1,26 @@
+#ifndef NATIVE_AVR_EEPROM_H
+#define NATIVE_AVR_EEPROM_H
+/* Host shim for <avr/eeprom.h>: the ATmega328P's 1 KB EEPROM becomes an array that starts
+ * erased (0xFF) and is always ready. hostEepromWrites counts, per cell, the updates that
+ * changed its value, so host tests can check wear levelling.*/
+#include <stdint.h>
+
+#define E2END 0x3FF
+
+extern uint8_t hostEeprom[E2END + 1];
+extern uint32_t hostEepromWrites[E2END + 1];
+
+static inline uint8_t eeprom_read_byte(const uint8_t *address) {
+    return hostEeprom[(uintptr_t)address];
+}
+
+static inline void eeprom_update_byte(uint8_t *address, uint8_t value) {
+    if (hostEeprom[(uintptr_t)address] != value) {
+        hostEeprom[(uintptr_t)address] = value;
+        hostEepromWrites[(uintptr_t)address]++;
+    }
+}
+
+#define eeprom_is_ready() 1
+
+#endif
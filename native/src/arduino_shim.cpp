@@ -0,0 +1,83 @@
+#include <Arduino.h>
+#include <avr/eeprom.h>
+#include <stdio.h>
+#include <time.h>
+
+volatile uint8_t ADCL, ADCH, ADMUX, ADCSRA, ADCSRB, DIDR0;
+volatile uint8_t TCCR1A, TCCR1B, TIMSK1, ICR1H, ICR1L, OCR1AL, OCR1BL;
+volatile uint16_t OCR1A, OCR1B;
+volatile uint8_t DDRB, SREG, TIFR1;
+volatile uint8_t TCCR2A, TCCR2B, TCNT2;
+volatile uint8_t PINB = 0xFF, PINC = 0xFF, PIND = 0xFF;
+
+HardwareSerial Serial;
+
+uint8_t hostEeprom[E2END + 1];
+uint32_t hostEepromWrites[E2END + 1];
+
+/*A new part: every EEPROM cell erased*/
+static struct HostEepromErase {
+    HostEepromErase() { memset(hostEeprom, 0xFF, sizeof(hostEeprom)); }
+} hostEepromErase;
+
+static uint8_t serialInput[256]; // Bytes queued by serialHostInput()
+static size_t serialInputLength = 0;
+static size_t serialInputNext = 0;
+
+static unsigned long hostMillisOffset = 0; // Added by hostAdvanceMillis()
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin; (void)mode;
+}
+
+int digitalRead(uint8_t pin) {
+    (void)pin;
+    return HIGH; // All buttons released (inputs use pullups)
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    (void)pin; (void)val;
+}
+
+static unsigned long elapsedMicros(void) {
+    static struct timespec start;
+    static bool started = false;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (!started) {
+        start = now;
+        started = true;
+    }
+    return (unsigned long)((now.tv_sec - start.tv_sec) * 1000000L + (now.tv_nsec - start.tv_nsec) / 1000L);
+}
+
+unsigned long millis(void) { return elapsedMicros() / 1000UL + hostMillisOffset; }
+unsigned long micros(void) { return elapsedMicros() + hostMillisOffset * 1000UL; }
+void hostAdvanceMillis(unsigned long ms) { hostMillisOffset += ms; }
+
+void HardwareSerial::begin(unsigned long baud) { (void)baud; }
+void serialHostInput(const uint8_t *data, size_t length) {
+    if (length > sizeof(serialInput)) length = sizeof(serialInput);
+    memcpy(serialInput, data, length);
+    serialInputLength = length;
+    serialInputNext = 0;
+}
+
+int HardwareSerial::available(void) { return (int)(serialInputLength - serialInputNext); }
+int HardwareSerial::read(void) { return serialInputNext < serialInputLength ? serialInput[serialInputNext++] : -1; }
+int HardwareSerial::availableForWrite(void) { return 63; } // Never full: stderr does not block
+size_t HardwareSerial::write(uint8_t c) { return fputc(c, stderr) == EOF ? 0 : 1; }
+size_t HardwareSerial::print(const char *s) { return fprintf(stderr, "%s", s); }
+size_t HardwareSerial::print(const __FlashStringHelper *s) { return print(reinterpret_cast<const char *>(s)); }
+size_t HardwareSerial::print(char c) { return write((uint8_t)c); }
+size_t HardwareSerial::print(int n) { return fprintf(stderr, "%d", n); }
+size_t HardwareSerial::print(unsigned int n) { return fprintf(stderr, "%u", n); }
+size_t HardwareSerial::print(long n) { return fprintf(stderr, "%ld", n); }
+size_t HardwareSerial::print(unsigned long n) { return fprintf(stderr, "%lu", n); }
+size_t HardwareSerial::print(double n) { return fprintf(stderr, "%.2f", n); }
+size_t HardwareSerial::println(void) { return write('\n'); }
@@ -0,0 +1,449 @@
+/* Host renderer for [env:native].
+ * Streams a WAV or raw 10-bit PCM file through the real TIMER1_CAPT_vect and effect
+ * kernels from src/, one ADC sample at a time, and writes the PWM output back to a file.
+ *
+ *   pedal_host [-m mode] [-v volume] [-r] [-c] [input|-] [output|-]
+ *
+ *   -m mode    clean, normal, reverb, delay, echo, octaver, distortion, sinewave, chorus,
+ *              flanger, vibrato, tremolo, chain, looper
+ *              (default normal; chain runs EFFECT_CHAIN_DEFAULT)
+ *   -v volume  master volume 0-1024, as set by PUSHBUTTON_1/2 (default 1024)
+ *   -r         raw mode: input and output are little-endian 16-bit words holding
+ *              10-bit samples (0-1023) at the pedal sample rate
+ *   -c         codec report: instead of the pedal, runs the 10-bit input through the
+ *              looper's ADPCM codec (adpcm.h, looper.h) and writes the decoded samples;
+ *              reports its SNR, at the sample rate and as the looper stores it, and its
+ *              cost per sample on this host
+ *
+ * WAV input may be 8 or 16-bit PCM at any rate and channel count; it is mixed to mono
+ * and linearly resampled to the pedal rate. WAV output is 16-bit mono at the pedal rate.
+ * "-" (or a missing argument) means stdin/stdout, so long files are never held in memory.
+ * Throughput is reported on stderr.
+ * Samples reach the ISR through the SAMPLE_IO_BUFFER backend (sampleio.h), a chunk at a
+ * time. Built with SAMPLE_IO_BACKEND=SAMPLE_IO_STREAM instead, the ISR reads and writes
+ * the files itself; that build takes raw files (-r) only.
+ * Left out of the unit test build (PIO_UNIT_TESTING), which brings its own main().*/
+#ifndef PIO_UNIT_TESTING
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "main.h"
+#include "audioblock.h"
+#include "outputgain.h"
+#include "transition.h"
+#include "sampleio.h"
+#include "adpcm.h"
+#include "echo.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HOST_CYCLES() __rdtsc()
+#endif
+
+extern void setup(void);
+extern "C" void TIMER1_CAPT_vect(void);
+
+#define HOST_CHUNK 256
+
+static const unsigned long PEDAL_SAMPLE_RATE = F_CPU / AUDIO_SAMPLE_PERIOD_CYCLES;
+
+struct ModeName {
+    const char *name;
+    EffectMode mode;
+};
+
+static const ModeName modeNames[] = {
+    {"clean", CLEAN_MODE},
+    {"normal", NORMAL_MODE},
+    {"reverb", REVERB_ECHO_MODE},
+    {"delay", DELAY_MODE},
+    {"echo", ECHO_MODE},
+    {"octaver", OCTAVER_MODE},
+    {"distortion", DISTORTION_MODE},
+    {"sinewave", SINEWAVE_MODE},
+    {"chorus", CHORUS_MODE},
+    {"flanger", FLANGER_MODE},
+    {"vibrato", VIBRATO_MODE},
+    {"tremolo", TREMOLO_MODE},
+    {"chain", CHAIN_MODE},
+    {"looper", LOOPER_MODE},
+};
+
+/*Streaming WAV input state*/
+struct WavInput {
+    FILE *file;
+    uint16_t channels;
+    uint16_t bitsPerSample;
+    uint32_t sampleRate;
+    uint32_t bytesLeft; // 0xFFFFFFFF when the writer did not know the length
+};
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+#if SAMPLE_IO_BACKEND != SAMPLE_IO_STREAM // Raw streams are read and written by the backend itself
+static uint16_t readLe16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static uint32_t readLe32(const uint8_t *p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+static void writeLe16(uint8_t *p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+static void writeLe32(uint8_t *p, uint32_t v) { writeLe16(p, v & 0xFFFF); writeLe16(p + 2, v >> 16); }
+
+static bool skipBytes(FILE *file, uint32_t count) {
+    uint8_t scratch[256];
+    while (count > 0) {
+        size_t n = count > sizeof(scratch) ? sizeof(scratch) : count;
+        if (fread(scratch, 1, n, file) != n) return false;
+        count -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief: Parses the RIFF header up to the start of the data chunk without seeking,
+ * so it also works on pipes.
+ */
+static bool openWavInput(WavInput *wav) {
+    uint8_t header[12];
+    if (fread(header, 1, 12, wav->file) != 12 || memcmp(header, "RIFF", 4) || memcmp(header + 8, "WAVE", 4)) {
+        fprintf(stderr, "input is not a RIFF/WAVE file (use -r for raw 10-bit PCM)\n");
+        return false;
+    }
+    bool haveFormat = false;
+    for (;;) {
+        uint8_t chunk[8];
+        if (fread(chunk, 1, 8, wav->file) != 8) {
+            fprintf(stderr, "WAV file has no data chunk\n");
+            return false;
+        }
+        uint32_t size = readLe32(chunk + 4);
+        if (!memcmp(chunk, "fmt ", 4)) {
+            uint8_t fmt[16];
+            if (size < 16 || fread(fmt, 1, 16, wav->file) != 16) return false;
+            if (readLe16(fmt) != 1) {
+                fprintf(stderr, "only PCM WAV files are supported\n");
+                return false;
+            }
+            wav->channels = readLe16(fmt + 2);
+            wav->sampleRate = readLe32(fmt + 4);
+            wav->bitsPerSample = readLe16(fmt + 14);
+            if ((wav->bitsPerSample != 8 && wav->bitsPerSample != 16) || wav->channels == 0) {
+                fprintf(stderr, "only 8 or 16-bit PCM WAV files are supported\n");
+                return false;
+            }
+            if (!skipBytes(wav->file, size - 16 + (size & 1))) return false;
+            haveFormat = true;
+        } else if (!memcmp(chunk, "data", 4)) {
+            if (!haveFormat) return false;
+            wav->bytesLeft = (size == 0) ? 0xFFFFFFFFUL : size; // 0 is used by some streaming writers
+            return true;
+        } else if (!skipBytes(wav->file, size + (size & 1))) {
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief: Reads one frame, mixed down to a mono 16-bit sample.
+ * @return false at the end of the data.
+ */
+static bool readWavFrame(WavInput *wav, int16_t *sample) {
+    uint8_t frame[2 * 16];
+    uint16_t bytesPerFrame = wav->channels * (wav->bitsPerSample / 8);
+    if (bytesPerFrame > sizeof(frame) || wav->bytesLeft < bytesPerFrame) return false;
+    if (fread(frame, 1, bytesPerFrame, wav->file) != bytesPerFrame) return false;
+    if (wav->bytesLeft != 0xFFFFFFFFUL) wav->bytesLeft -= bytesPerFrame;
+    int32_t sum = 0;
+    for (uint16_t ch = 0; ch < wav->channels; ch++) {
+        sum += (wav->bitsPerSample == 16) ? (int16_t)readLe16(frame + 2 * ch) : ((int16_t)frame[ch] - 128) << 8;
+    }
+    *sample = (int16_t)(sum / wav->channels);
+    return true;
+}
+
+static void writeWavHeader(FILE *file, uint32_t dataBytes) {
+    uint8_t header[44];
+    memcpy(header, "RIFF", 4);
+    writeLe32(header + 4, dataBytes == 0xFFFFFFFFUL ? dataBytes : dataBytes + 36);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    writeLe32(header + 16, 16);
+    writeLe16(header + 20, 1);                     // PCM
+    writeLe16(header + 22, 1);                     // mono
+    writeLe32(header + 24, PEDAL_SAMPLE_RATE);
+    writeLe32(header + 28, PEDAL_SAMPLE_RATE * 2); // byte rate
+    writeLe16(header + 32, 2);                     // block align
+    writeLe16(header + 34, 16);                    // bits per sample
+    memcpy(header + 36, "data", 4);
+    writeLe32(header + 40, dataBytes);
+    fwrite(header, 1, sizeof(header), file);
+}
+#endif
+
+#if SAMPLE_IO_BACKEND == SAMPLE_IO_BUFFER
+/**
+ * @brief: Runs the capture ISR once per sample of block, in place.
+ */
+static void runPedalBlock(int16_t *block, size_t count) {
+    sampleIoBufferBind(block, block); // Each sample is read before its slot is written
+    for (size_t i = 0; i < count; i++) {
+        TIMER1_CAPT_vect();
+    }
+}
+#elif SAMPLE_IO_BACKEND == SAMPLE_IO_TIMER1_PWM
+/**
+ * @brief: Same through the shim's ADC and PWM registers, the way the pedal sees samples.
+ */
+static void runPedalBlock(int16_t *block, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint16_t adc = ((uint16_t)block[i] ^ 0x8000) & 0xFFC0; // Left-adjusted 10-bit conversion
+        ADCL = adc & 0xFF;
+        ADCH = adc >> 8;
+        TIMER1_CAPT_vect();
+#if PWM_BITS == 8
+        block[i] = (int16_t)((((uint16_t)OCR1AL << 8) | OCR1BL) ^ 0x8000);
+#else
+        block[i] = (int16_t)(((OCR1A << (16 - PWM_BITS)) | (OCR1B >> (PWM_BITS - 8))) ^ 0x8000);
+#endif
+    }
+}
+#endif
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#if SAMPLE_IO_BACKEND != SAMPLE_IO_STREAM
+/*Signal and error energy of an ADPCM round trip*/
+struct CodecStats {
+    AdpcmState encoder;
+    AdpcmState decoder;
+    double signal;
+    double error;
+    unsigned long long samples;
+};
+
+/*Codec report state: at the sample rate, and decimated as the looper stores it*/
+struct CodecReport {
+    CodecStats full;
+    CodecStats stored;
+    q15_t sum;         // Looper decimation: input summed over LOOPER_DECIMATION samples
+    uint8_t subSample;
+    double seconds;    // Spent in the full-rate encode and decode
+    unsigned long long cycles;
+};
+
+static inline void codecAccount(CodecStats &stats, q15_t sample, q15_t decoded) {
+    double error = (double)decoded - sample;
+    stats.signal += (double)sample * sample;
+    stats.error += error * error;
+    stats.samples++;
+}
+
+/**
+ * @brief: Runs a block through the codec in place, cut to 10 bits as the pedal's ADC
+ * delivers it, timing the round trips. Then adds it to both SNR sums.
+ */
+static void runCodecBlock(CodecReport &report, int16_t *block, size_t count) {
+    q15_t input[HOST_CHUNK];
+    for (size_t i = 0; i < count; i++) {
+        input[i] = block[i] & SAMPLE_IO_ADC_MASK;
+    }
+    CodecStats &full = report.full;
+    double start = nowSeconds();
+#ifdef HOST_CYCLES
+    unsigned long long cycles = HOST_CYCLES();
+#endif
+    for (size_t i = 0; i < count; i++) {
+        block[i] = adpcmDecode(full.decoder, adpcmEncode(full.encoder, input[i]));
+    }
+#ifdef HOST_CYCLES
+    report.cycles += HOST_CYCLES() - cycles;
+#endif
+    report.seconds += nowSeconds() - start;
+
+    CodecStats &stored = report.stored;
+    for (size_t i = 0; i < count; i++) {
+        codecAccount(full, input[i], block[i]);
+        report.sum += input[i] >> LOOPER_DECIMATION_LOG2;
+        if (++report.subSample == LOOPER_DECIMATION) {
+            codecAccount(stored, report.sum, adpcmDecode(stored.decoder, adpcmEncode(stored.encoder, report.sum)));
+            report.sum = 0;
+            report.subSample = 0;
+        }
+    }
+}
+
+static double codecSnrDb(const CodecStats &stats) {
+    return stats.error > 0 ? 10.0 * log10(stats.signal / stats.error) : INFINITY;
+}
+
+static void printCodecReport(const CodecReport &report) {
+    unsigned long long samples = report.full.samples;
+    fprintf(stderr, "ADPCM codec SNR: %.1f dB at %lu Hz, %.1f dB stored by the looper at %lu Hz\n",
+            codecSnrDb(report.full), PEDAL_SAMPLE_RATE, codecSnrDb(report.stored),
+            PEDAL_SAMPLE_RATE >> LOOPER_DECIMATION_LOG2);
+    fprintf(stderr, "Encode + decode per sample: %.1f ns", samples ? 1e9 * report.seconds / samples : 0.0);
+#ifdef HOST_CYCLES
+    fprintf(stderr, ", %.1f TSC cycles", samples ? (double)report.cycles / samples : 0.0);
+#endif
+    fprintf(stderr, " on this host; declared on the ATmega328P: %d cycles, LOOPER_MODE %d cycles "
+            "(measure with tools/benchmark.py)\n", ADPCM_ENCODE_CYCLES + ADPCM_DECODE_CYCLES, LOOPER_CYCLES);
+}
+#endif
+
+static void usage(void) {
+    fprintf(stderr, "usage: pedal_host [-m mode] [-v volume] [-r] [-c] [input|-] [output|-]\nmodes:");
+    for (size_t i = 0; i < sizeof(modeNames) / sizeof(modeNames[0]); i++) {
+        fprintf(stderr, " %s", modeNames[i].name);
+    }
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char **argv) {
+    EffectMode mode = NORMAL_MODE;
+    int volume = 1024;
+    bool raw = false;
+    bool codec = false;
+    const char *inPath = "-";
+    const char *outPath = "-";
+    int positional = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-m") && i + 1 < argc) {
+            const char *name = argv[++i];
+            size_t m;
+            for (m = 0; m < sizeof(modeNames) / sizeof(modeNames[0]); m++) {
+                if (!strcmp(name, modeNames[m].name)) break;
+            }
+            if (m == sizeof(modeNames) / sizeof(modeNames[0])) {
+                usage();
+                return 2;
+            }
+            mode = modeNames[m].mode;
+        } else if (!strcmp(argv[i], "-v") && i + 1 < argc) {
+            volume = atoi(argv[++i]);
+            volume = constrain(volume, 0, 1024); // constrain() is a macro: no side effects in its arguments
+        } else if (!strcmp(argv[i], "-r")) {
+            raw = true;
+        } else if (!strcmp(argv[i], "-c")) {
+            codec = true;
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            usage();
+            return 2;
+        } else if (positional == 0) {
+            inPath = argv[i];
+            positional++;
+        } else if (positional == 1) {
+            outPath = argv[i];
+            positional++;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    FILE *in = strcmp(inPath, "-") ? fopen(inPath, "rb") : stdin;
+    FILE *out = strcmp(outPath, "-") ? fopen(outPath, "wb") : stdout;
+    if (!in || !out) {
+        perror("pedal_host");
+        return 1;
+    }
+
+    setup();
+    pot2_value = volume;
+    outputGainSetVolume(volume, true); // No fade-in: renders start at the set level
+    lastSelectedMode = mode;
+    transitionSetup(mode);
+    effectActive = (mode != CLEAN_MODE);
+
+    unsigned long long totalSamples = 0;
+    double kernelSeconds = 0.0;
+
+#if SAMPLE_IO_BACKEND == SAMPLE_IO_STREAM
+    if (!raw || codec) {
+        fprintf(stderr, "this build streams raw 10-bit PCM through the pedal only (-r, no -c)\n");
+        return 2;
+    }
+    sampleIoStreamBind(in, out);
+    double start = nowSeconds();
+    for (;;) {
+        TIMER1_CAPT_vect();
+        if (sampleIoStreamEnded) break;
+        totalSamples++;
+    }
+    kernelSeconds = nowSeconds() - start; // Includes the file I/O
+#else
+    WavInput wav = {in, 1, 16, PEDAL_SAMPLE_RATE, 0xFFFFFFFFUL};
+    if (!raw) {
+        if (!openWavInput(&wav)) return 1;
+        writeWavHeader(out, 0xFFFFFFFFUL); // Patched below when the output is seekable
+    }
+
+    /*Linear resampler state, in input samples*/
+    const double step = (double)wav.sampleRate / PEDAL_SAMPLE_RATE;
+    double phase = 1.0;
+    int16_t previous = 0, current = 0;
+    bool inputDone = false;
+
+    int16_t block[HOST_CHUNK];
+    uint8_t bytes[2 * HOST_CHUNK];
+    CodecReport report;
+    memset(&report, 0, sizeof(report));
+
+    while (!inputDone) {
+        size_t count = 0;
+        if (raw) {
+            size_t n = fread(bytes, 2, HOST_CHUNK, in);
+            for (count = 0; count < n; count++) {
+                block[count] = q15From10Bit(readLe16(bytes + 2 * count) & 0x3FF);
+            }
+            inputDone = (n < HOST_CHUNK);
+        } else {
+            while (count < HOST_CHUNK) {
+                while (phase >= 1.0) {
+                    previous = current;
+                    if (!readWavFrame(&wav, &current)) {
+                        inputDone = true;
+                        break;
+                    }
+                    phase -= 1.0;
+                }
+                if (inputDone) break;
+                block[count++] = (int16_t)(previous + (current - previous) * phase);
+                phase += step;
+            }
+        }
+
+        double start = nowSeconds();
+        if (codec) {
+            runCodecBlock(report, block, count);
+        } else {
+            runPedalBlock(block, count);
+        }
+        kernelSeconds += nowSeconds() - start;
+        totalSamples += count;
+
+        for (size_t i = 0; i < count; i++) {
+            writeLe16(bytes + 2 * i, raw ? q15To10Bit(block[i]) : (uint16_t)block[i]);
+        }
+        if (fwrite(bytes, 2, count, out) != count) {
+            perror("pedal_host");
+            return 1;
+        }
+    }
+
+    if (!raw && out != stdout && totalSamples * 2 < 0xFFFFFFFFULL && fseek(out, 0, SEEK_SET) == 0) {
+        writeWavHeader(out, (uint32_t)(totalSamples * 2));
+    }
+    if (codec) printCodecReport(report);
+#endif
+    if (in != stdin) fclose(in);
+    if (out != stdout) fclose(out);
+
+    double audioSeconds = (double)totalSamples / PEDAL_SAMPLE_RATE;
+    fprintf(stderr, "%llu samples (%.2f s of audio at %lu Hz) in %.3f s: %.0f samples/s, %.1fx real time\n",
+            totalSamples, audioSeconds, PEDAL_SAMPLE_RATE, kernelSeconds,
+            kernelSeconds > 0 ? totalSamples / kernelSeconds : 0.0,
+            kernelSeconds > 0 ? audioSeconds / kernelSeconds : 0.0);
+    return 0;
+}
+#endif
@@ -0,0 +1,47 @@
+#include "effects.h"
+#include <Arduino.h>
+
+ActiveEffects::Arena effectArena; // Zero-initialized: every delay line starts silent
+
+static_assert(sizeof(ActiveEffects::Arena) <= EFFECT_ARENA_BYTES + SRAM_HOST_PADDING_BYTES,
+              "Effect state exceeds EFFECT_ARENA_BYTES; shrink a delay line, drop an effect from ActiveEffects, "
+              "build with the Serial ring sizes of platformio.ini or leave out an optional module (main.h)");
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Bytes between the top of the heap/static data and the current stack pointer.
+ */
+static int freeStackBytes(void) {
+#if defined(__AVR__)
+    extern char __heap_start; // Nothing allocates, so the heap is empty: __brkval would only link in malloc's state
+    char top;
+    return &top - &__heap_start;
+#else
+    return -1; // Not meaningful off target
+#endif
+}
+
+/**
+ * @brief: Prints how much of the arena and parameter banks is used and what is left for the stack.
+ * Stops the pedal when less than STACK_RESERVE_BYTES is free: the stack would run into
+ * the globals long before anything else shows it.
+ * This function is called once in setup().
+ */
+void arenaReport(void) {
+    int freeBytes = freeStackBytes();
+    Serial.print(F("Effect arena: ")); Serial.print((unsigned int)sizeof(ActiveEffects::Arena));
+    Serial.print(F(" of ")); Serial.print(EFFECT_ARENA_BYTES + SRAM_HOST_PADDING_BYTES);
+    Serial.print(F(" bytes, parameter banks: ")); Serial.print((unsigned int)sizeof(ActiveEffects::ParamLayout));
+    Serial.print(F(" of ")); Serial.print(PARAM_BANK_BYTES);
+    Serial.print(F(" bytes, free for stack: ")); Serial.println(freeBytes);
+#if defined(__AVR__)
+    if (freeBytes < STACK_RESERVE_BYTES) {
+        Serial.print(F("ERROR: less than STACK_RESERVE_BYTES (")); Serial.print(STACK_RESERVE_BYTES);
+        Serial.println(F(") free; trim globals or the arena. Halted."));
+        Serial.flush();
+        noInterrupts();
+        for (;;) {
+        }
+    }
+#endif
+}
@@ -0,0 +1,58 @@
+#include "audioblock.h"
+#include "arena.h"
+#include <Arduino.h>
+
+#ifdef AUDIO_BLOCK_MODE
+q15_t audioInBlock[2][AUDIO_BLOCK_SIZE];
+q15_t audioOutBlock[2][AUDIO_BLOCK_SIZE];
+volatile uint8_t audioBlockIndex = 0;
+volatile uint8_t audioBlockHalf = 0;
+volatile bool audioBlockReady = false;
+volatile uint16_t audioBlockOverruns = 0;
+
+static volatile bool audioBlockBusy = false;
+
+static_assert(sizeof(audioInBlock) + sizeof(audioOutBlock) + 6 <= AUDIO_BLOCK_SRAM_BYTES,
+              "Block buffers outgrew AUDIO_BLOCK_SRAM_BYTES (arena.h)");
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Clears both halves to silence and reports the added latency.
+ * This function is called once in setup(), before the Timer1 ISR is enabled.
+ */
+void audioBlockSetup(void) {
+    for (uint8_t half = 0; half < 2; half++) {
+        for (uint8_t i = 0; i < AUDIO_BLOCK_SIZE; i++) {
+            audioInBlock[half][i] = 0;
+            audioOutBlock[half][i] = 0;
+        }
+    }
+    audioBlockIndex = 0;
+    audioBlockHalf = 0;
+    audioBlockReady = false;
+
+    Serial.print(F("Block mode: ")); Serial.print(AUDIO_BLOCK_SIZE);
+    Serial.print(F(" samples, latency ")); Serial.print(AUDIO_BLOCK_LATENCY_US); Serial.println(F(" us"));
+}
+
+/**
+ * @brief: Processes the block the ISR just finished filling.
+ * Called at the tail of TIMER1_CAPT_vect. Interrupts are re-enabled while the block
+ * runs, so the capture ISR keeps exchanging samples on time and only ever does the
+ * cheap audioBlockExchange() while a block is being processed. loop() is not used for
+ * this because its Serial prints can block for far longer than a block.
+ */
+void audioBlockService(void) {
+    if (!audioBlockReady || audioBlockBusy) {
+        return;
+    }
+    audioBlockBusy = true;
+    audioBlockReady = false;
+    uint8_t half = audioBlockHalf ^ 1; // The half the ISR is not using
+    EffectMode mode = currentActiveMode;
+    sei();
+    processAudioBlock(mode, audioInBlock[half], audioOutBlock[half], AUDIO_BLOCK_SIZE);
+    cli();
+    audioBlockBusy = false;
+}
+#endif
@@ -0,0 +1,60 @@
+#include "benchmark.h"
+#include "effects.h"
+#include "transition.h"
+#include "effectchain.h"
+#include <Arduino.h>
+
+#ifdef BENCHMARK
+static uint8_t benchmarkMode = NUM_EFFECTS_ENUM; // Mode being measured, NUM_EFFECTS_ENUM before the first
+static unsigned long benchmarkStartMs;
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Next mode compiled in after mode, or NUM_EFFECTS_ENUM after the last.
+ */
+static uint8_t benchmarkNextMode(uint8_t mode) {
+    for (mode = (mode == NUM_EFFECTS_ENUM) ? 0 : mode + 1; mode < NUM_EFFECTS_ENUM; mode++) {
+        if (mode == CLEAN_MODE || mode == CHAIN_MODE || ActiveEffects::enabled((EffectMode)mode)) break;
+    }
+    return mode;
+}
+
+/**
+ * @brief: Prints the declared ISR cycles of every mode the walk measures, one
+ * "Declared cycles: <mode> <cycles>" line each (see benchmark.h). Called from setup().
+ */
+void benchmarkSetup(void) {
+    for (uint8_t mode = benchmarkNextMode(NUM_EFFECTS_ENUM); mode < NUM_EFFECTS_ENUM; mode = benchmarkNextMode(mode)) {
+        uint32_t cycles = (mode == CHAIN_MODE) ? effectChainCycles(effectChain, effectChainLength)
+                                               : ActiveEffects::cycles((EffectMode)mode);
+        Serial.print(F("Declared cycles: ")); Serial.print(mode);
+        Serial.print(' '); Serial.println(ISR_FIXED_CYCLES + cycles);
+    }
+}
+
+/**
+ * @brief: Steps to the next mode every BENCHMARK_MODE_MS and tags the coming ISRs in
+ * GPIOR0 (see benchmark.h). Called from loop().
+ */
+void benchmarkService(void) {
+    unsigned long now = millis();
+    if (benchmarkMode == NUM_EFFECTS_ENUM || now - benchmarkStartMs >= BENCHMARK_MODE_MS) {
+        uint8_t next = benchmarkNextMode(benchmarkMode);
+        if (next == NUM_EFFECTS_ENUM && benchmarkMode != NUM_EFFECTS_ENUM) {
+            GPIOR0 = BENCHMARK_TAG_DONE;
+            return;
+        }
+        benchmarkMode = next;
+        benchmarkStartMs = now;
+        transitionTo((EffectMode)next);
+    }
+
+    if (transition.phase != TRANSITION_IDLE || currentActiveMode != benchmarkMode) {
+        GPIOR0 = BENCHMARK_TAG_TRANSITION;
+    } else if (now - benchmarkStartMs < BENCHMARK_SETTLE_MS) {
+        GPIOR0 = BENCHMARK_TAG_SETTLING;
+    } else {
+        GPIOR0 = benchmarkMode;
+    }
+}
+#endif
@@ -1,13 +1,21 @@
 #include "distortion.h"
+#include "effects.h"
 #include <Arduino.h>
 
+static const char distortionCurveNames[NUM_DISTORTION_CURVES][9] PROGMEM = {"TANH", "TUBE", "FOLDBACK", "HARD"};
+
+const ParamInfo distortionParamTable[DISTORTION_PARAM_COUNT] PROGMEM = {
+    PARAM_ENTRY("dist.drive", PARAM_Q7_8, DistortionParams, drive, FLOAT_TO_Q7_8(1.0), FLOAT_TO_Q7_8(8.0), FLOAT_TO_Q7_8(3.5)),
+    PARAM_ENTRY("dist.curve", PARAM_U8, DistortionParams, curve, 0, NUM_DISTORTION_CURVES - 1, DISTORTION_CURVE_TANH),
+};
+
 /*********************************************FUNCTION DEFINITIONS****************************************************/
 void pinConfigDistortion(){
     // No specific pins for Distortion, common pins configured in main.cpp
 }
 
 void setupDistortion(){
-    Serial.println("Distortion Pedal Ready!");
+    Serial.println(F("Distortion Pedal Ready!"));
 }
 
 void loopDistortion(){
@@ -15,53 +23,46 @@ void loopDistortion(){
 }
 
 /**
- * @brief: Audio processing function for Distortion effect.
- * Uses centered floating-point math for accurate clipping.
- * @param inputSample The raw 10-bit input audio sample (0-1023).
+ * @brief: Selects the waveshaper curve, like setting dist.curve. Safe to call while the ISR is running.
  */
-void processDistortionAudio(int inputSample) {
-    float outputSampleFloat; // Use float for processing
-    float centered_input = (float)inputSample - 511.5; // Center input to -511.5 to 511.5
-
-    if (effectActive) {
-        // --- Fixed Effect Parameters ---
-        const float fixedPreGainFactor = 3.5; // Example: 3.5x pre-gain
-        const int fixedDistortionThreshold = 150; // Example: 150 for threshold (smaller = more distortion)
-
-        // Apply fixed pre-gain to the centered input
-        float gained_input = centered_input * fixedPreGainFactor;
-
-        /* Apply Symmetrical Hard Clipping based on fixed threshold.
-         * Values outside this range are clamped.
-         */
-        if (gained_input > fixedDistortionThreshold) {
-            outputSampleFloat = fixedDistortionThreshold;
-        } else if (gained_input < -fixedDistortionThreshold) {
-            outputSampleFloat = -fixedDistortionThreshold;
-        } else {
-            outputSampleFloat = gained_input; // Signal is within threshold, no clipping
-        }
-    }
-    else {
-        outputSampleFloat = centered_input; // Pass through clean signal if effect is bypassed
-    }
+void distortionSelectCurve(DistortionCurve curve) {
+    if (curve >= NUM_DISTORTION_CURVES) return;
+    ParamBank<DistortionParams> &bank = effectParams<DistortionEffect>();
+    bank.stage().curve = curve;
+    bank.publish();
+    Serial.print(F("Distortion Curve: ")); Serial.println((const __FlashStringHelper *)distortionCurveNames[curve]);
+}
 
-    // --- Final Output Processing ---
-    // Re-bias the processed sample to 0-1023 range
-    int finalOutputSample = (int)(outputSampleFloat + 511.5);
+/**
+ * @brief: Steps to the next waveshaper curve, wrapping around after the last one.
+ */
+void distortionNextCurve(void) {
+    uint8_t next = effectParams<DistortionEffect>().live().curve + 1;
+    distortionSelectCurve((next < NUM_DISTORTION_CURVES) ? (DistortionCurve)next : DISTORTION_CURVE_TANH);
+}
 
-    // Apply global master volume controlled by PUSHBUTTON_1/2
-    float volume_factor = pot2_value / 1023.0;
-    finalOutputSample = (int)(finalOutputSample * volume_factor);
+/**
+ * @brief: Audio processing function for Distortion effect.
+ * Integer pre-gain, then a table lookup with linear interpolation and DC removal. Two flash
+ * reads and one 16x8 multiply whichever curve is selected.
+ * @param inputSample The centered Q15 input audio sample.
+ * @return The processed Q15 sample, before master volume.
+ */
+q15_t processDistortionAudio(q15_t inputSample) {
+    DistortionEffect::State &state = effectState<DistortionEffect>();
+    const DistortionParams &params = effectParams<DistortionEffect>().live();
 
-    // Constrain the final output to the valid 10-bit range (0-1023)
-    finalOutputSample = constrain(finalOutputSample, 0, 1023);
+    // Apply the drive to the centered input (saturates at the ends of the curve)
+    q15_t gained_input = q15Gain(inputSample, params.drive);
 
-    // // Split for dual PWM output
-    // analogWrite(AUDIO_OUT_A, finalOutputSample / 4);
-    // analogWrite(AUDIO_OUT_B, map(finalOutputSample % 4, 0, 3, 0, 255));
+    // Offset binary 0-65535: top 8 bits pick the entry, low 8 bits interpolate
+    uint16_t position = (uint16_t)gained_input ^ 0x8000;
+    const q15_t *entry = &distortionCurves[params.curve][position >> 8];
+    q15_t y0 = (q15_t)pgm_read_word(entry);
+    q15_t y1 = (q15_t)pgm_read_word(entry + 1);
+    q15_t shaped = y0 + (q15_t)(((int32_t)(y1 - y0) * (uint8_t)position) >> 8);
 
-    /*write the PWM output signal*/
-    OCR1AL = ((finalOutputSample + 0x8000) >> 8); // convert to unsigned, send out high byte
-    OCR1BL = finalOutputSample; // send out low byte
+    // Remove the offset the tube curve adds so it does not eat into later headroom
+    state.dcLevel += shaped - (state.dcLevel >> DISTORTION_DC_SHIFT);
+    return q15Sub(shaped, (q15_t)(state.dcLevel >> DISTORTION_DC_SHIFT));
 }
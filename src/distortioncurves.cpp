@@ -0,0 +1,101 @@
+/* Generated by tools/gen_distortion_curves.py - edit the script, not this file.*/
+#include "distortion.h"
+
+const q15_t distortionCurves[NUM_DISTORTION_CURVES][DISTORTION_CURVE_POINTS] PROGMEM = {
+    /*DISTORTION_CURVE_TANH*/ {
+        -9579, -9578, -9577, -9576, -9574, -9573, -9571, -9570, -9568, -9566, -9565, -9563,
+        -9561, -9558, -9556, -9554, -9551, -9549, -9546, -9543, -9540, -9536, -9533, -9529,
+        -9525, -9521, -9517, -9513, -9508, -9503, -9497, -9492, -9486, -9480, -9473, -9466,
+        -9459, -9451, -9443, -9435, -9426, -9416, -9406, -9396, -9385, -9373, -9361, -9348,
+        -9334, -9320, -9305, -9289, -9272, -9255, -9236, -9217, -9196, -9174, -9152, -9128,
+        -9102, -9076, -9048, -9019, -8988, -8955, -8921, -8886, -8848, -8809, -8767, -8723,
+        -8678, -8630, -8579, -8527, -8471, -8413, -8353, -8289, -8222, -8152, -8079, -8003,
+        -7923, -7840, -7753, -7662, -7567, -7468, -7365, -7257, -7145, -7029, -6907, -6782,
+        -6651, -6515, -6375, -6229, -6078, -5922, -5761, -5595, -5423, -5246, -5064, -4877,
+        -4684, -4487, -4284, -4076, -3864, -3648, -3426, -3201, -2971, -2738, -2501, -2261,
+        -2017, -1771, -1523, -1272, -1020, -766, -512, -256, 0, 256, 512, 766,
+        1020, 1272, 1523, 1771, 2017, 2261, 2501, 2738, 2971, 3201, 3426, 3648,
+        3864, 4076, 4284, 4487, 4684, 4877, 5064, 5246, 5423, 5595, 5761, 5922,
+        6078, 6229, 6375, 6515, 6651, 6782, 6907, 7029, 7145, 7257, 7365, 7468,
+        7567, 7662, 7753, 7840, 7923, 8003, 8079, 8152, 8222, 8289, 8353, 8413,
+        8471, 8527, 8579, 8630, 8678, 8723, 8767, 8809, 8848, 8886, 8921, 8955,
+        8988, 9019, 9048, 9076, 9102, 9128, 9152, 9174, 9196, 9217, 9236, 9255,
+        9272, 9289, 9305, 9320, 9334, 9348, 9361, 9373, 9385, 9396, 9406, 9416,
+        9426, 9435, 9443, 9451, 9459, 9466, 9473, 9480, 9486, 9492, 9497, 9503,
+        9508, 9513, 9517, 9521, 9525, 9529, 9533, 9536, 9540, 9543, 9546, 9549,
+        9551, 9554, 9556, 9558, 9561, 9563, 9565, 9566, 9568, 9570, 9571, 9573,
+        9574, 9576, 9577, 9578, 9579,
+    },
+    /*DISTORTION_CURVE_TUBE*/ {
+        -9569, -9567, -9566, -9564, -9562, -9560, -9557, -9555, -9553, -9550, -9547, -9544,
+        -9541, -9538, -9535, -9531, -9528, -9524, -9519, -9515, -9510, -9506, -9500, -9495,
+        -9489, -9483, -9477, -9470, -9463, -9456, -9448, -9440, -9431, -9422, -9412, -9402,
+        -9391, -9380, -9368, -9356, -9343, -9329, -9314, -9299, -9283, -9266, -9248, -9229,
+        -9210, -9189, -9167, -9144, -9120, -9094, -9068, -9040, -9010, -8979, -8947, -8913,
+        -8877, -8840, -8800, -8759, -8716, -8670, -8623, -8573, -8521, -8467, -8410, -8350,
+        -8288, -8223, -8155, -8084, -8010, -7933, -7853, -7769, -7682, -7592, -7498, -7400,
+        -7299, -7194, -7085, -6972, -6856, -6735, -6611, -6482, -6350, -6214, -6074, -5929,
+        -5781, -5630, -5474, -5315, -5153, -4987, -4818, -4646, -4471, -4293, -4113, -3930,
+        -3745, -3559, -3370, -3181, -2990, -2798, -2606, -2413, -2221, -2028, -1836, -1645,
+        -1455, -1266, -1079, -893, -710, -528, -350, -173, 0, 170, 337, 501,
+        662, 819, 972, 1121, 1267, 1409, 1547, 1681, 1811, 1937, 2059, 2177,
+        2291, 2402, 2508, 2611, 2710, 2805, 2897, 2986, 3071, 3152, 3230, 3306,
+        3378, 3447, 3513, 3576, 3637, 3695, 3750, 3803, 3854, 3902, 3948, 3993,
+        4035, 4075, 4113, 4149, 4184, 4217, 4249, 4279, 4307, 4335, 4360, 4385,
+        4409, 4431, 4452, 4472, 4491, 4510, 4527, 4543, 4559, 4574, 4588, 4601,
+        4614, 4626, 4638, 4649, 4659, 4669, 4678, 4687, 4695, 4703, 4711, 4718,
+        4725, 4731, 4738, 4743, 4749, 4754, 4759, 4764, 4768, 4773, 4777, 4780,
+        4784, 4787, 4791, 4794, 4797, 4800, 4802, 4805, 4807, 4809, 4811, 4813,
+        4815, 4817, 4819, 4821, 4822, 4824, 4825, 4826, 4828, 4829, 4830, 4831,
+        4832, 4833, 4834, 4835, 4836, 4836, 4837, 4838, 4838, 4839, 4840, 4840,
+        4841, 4841, 4842, 4842, 4843,
+    },
+    /*DISTORTION_CURVE_FOLDBACK*/ {
+        5632, 5888, 6144, 6400, 6656, 6912, 7168, 7424, 7680, 7936, 8192, 8448,
+        8704, 8960, 9216, 9472, 9472, 9216, 8960, 8704, 8448, 8192, 7936, 7680,
+        7424, 7168, 6912, 6656, 6400, 6144, 5888, 5632, 5376, 5120, 4864, 4608,
+        4352, 4096, 3840, 3584, 3328, 3072, 2816, 2560, 2304, 2048, 1792, 1536,
+        1280, 1024, 768, 512, 256, 0, -256, -512, -768, -1024, -1280, -1536,
+        -1792, -2048, -2304, -2560, -2816, -3072, -3328, -3584, -3840, -4096, -4352, -4608,
+        -4864, -5120, -5376, -5632, -5888, -6144, -6400, -6656, -6912, -7168, -7424, -7680,
+        -7936, -8192, -8448, -8704, -8960, -9216, -9472, -9472, -9216, -8960, -8704, -8448,
+        -8192, -7936, -7680, -7424, -7168, -6912, -6656, -6400, -6144, -5888, -5632, -5376,
+        -5120, -4864, -4608, -4352, -4096, -3840, -3584, -3328, -3072, -2816, -2560, -2304,
+        -2048, -1792, -1536, -1280, -1024, -768, -512, -256, 0, 256, 512, 768,
+        1024, 1280, 1536, 1792, 2048, 2304, 2560, 2816, 3072, 3328, 3584, 3840,
+        4096, 4352, 4608, 4864, 5120, 5376, 5632, 5888, 6144, 6400, 6656, 6912,
+        7168, 7424, 7680, 7936, 8192, 8448, 8704, 8960, 9216, 9472, 9472, 9216,
+        8960, 8704, 8448, 8192, 7936, 7680, 7424, 7168, 6912, 6656, 6400, 6144,
+        5888, 5632, 5376, 5120, 4864, 4608, 4352, 4096, 3840, 3584, 3328, 3072,
+        2816, 2560, 2304, 2048, 1792, 1536, 1280, 1024, 768, 512, 256, 0,
+        -256, -512, -768, -1024, -1280, -1536, -1792, -2048, -2304, -2560, -2816, -3072,
+        -3328, -3584, -3840, -4096, -4352, -4608, -4864, -5120, -5376, -5632, -5888, -6144,
+        -6400, -6656, -6912, -7168, -7424, -7680, -7936, -8192, -8448, -8704, -8960, -9216,
+        -9472, -9472, -9216, -8960, -8704, -8448, -8192, -7936, -7680, -7424, -7168, -6912,
+        -6656, -6400, -6144, -5888, -5632,
+    },
+    /*DISTORTION_CURVE_HARD*/ {
+        -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600,
+        -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600,
+        -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600,
+        -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600,
+        -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600,
+        -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600,
+        -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9600,
+        -9600, -9600, -9600, -9600, -9600, -9600, -9600, -9472, -9216, -8960, -8704, -8448,
+        -8192, -7936, -7680, -7424, -7168, -6912, -6656, -6400, -6144, -5888, -5632, -5376,
+        -5120, -4864, -4608, -4352, -4096, -3840, -3584, -3328, -3072, -2816, -2560, -2304,
+        -2048, -1792, -1536, -1280, -1024, -768, -512, -256, 0, 256, 512, 768,
+        1024, 1280, 1536, 1792, 2048, 2304, 2560, 2816, 3072, 3328, 3584, 3840,
+        4096, 4352, 4608, 4864, 5120, 5376, 5632, 5888, 6144, 6400, 6656, 6912,
+        7168, 7424, 7680, 7936, 8192, 8448, 8704, 8960, 9216, 9472, 9600, 9600,
+        9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600,
+        9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600,
+        9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600,
+        9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600,
+        9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600,
+        9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600,
+        9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600, 9600,
+        9600, 9600, 9600, 9600, 9600,
+    },
+};
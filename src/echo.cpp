@@ -1,13 +1,19 @@
 #include "echo.h"
+#include "effects.h"
 #include <Arduino.h>
 
+const ParamInfo echoParamTable[ECHO_PARAM_COUNT] PROGMEM = {
+    PARAM_ENTRY("echo.time", PARAM_U16, EchoParams, time, DELAY_SAMPLES_TO_US(1), ECHO_MAX_US, ECHO_TIME_DEFAULT_US), // us
+    PARAM_ENTRY("echo.fdbk", PARAM_Q15, EchoParams, feedback, 0, FLOAT_TO_Q15(0.95), FLOAT_TO_Q15(0.65)),
+};
+
 /*********************************************FUNCTION DEFINITIONS****************************************************/
 void pinConfigEcho(){
     // No specific pins for Echo, common pins configured in main.cpp
 }
 
 void setupEcho(){
-    Serial.println("Echo Pedal Ready!");
+    Serial.println(F("Echo Pedal Ready!"));
 }
 
 void loopEcho(){
@@ -15,62 +21,46 @@ void loopEcho(){
 }
 
 /**
- * @brief: Audio processing function for Echo effect.
- * Uses centered floating-point math to prevent clipping and buzzing.
- * @param inputSample The raw 10-bit input audio sample (0-1023).
+ * @brief: Makes the next sample start the line or the loop afresh, whichever mode runs
+ * (see processEchoAudio() and processLooperAudio()).
  */
-void processEchoAudio(int inputSample) {
-    float outputSampleFloat; // Use float for processing
-    float centered_input = (float)inputSample - 511.5; // Center input to -511.5 to 511.5
-
-    if (effectActive) {
-        // --- Fixed Effect Parameters ---
-        const int fixedEchoDelayTimeValue = 600; // Delay time (e.g., 600 maps to ~MAX_DELAY/1.7)
-        const float fixedEchoFeedbackFactor = 0.65; // 65% feedback
-
-        int currentDelayDepth = map(fixedEchoDelayTimeValue, 0, 1023, 1, MAX_DELAY - 1);
-        int delayReadPointer = (delayWritePointer + (MAX_DELAY - currentDelayDepth)) % MAX_DELAY;
-
-        // Get delayed sample from buffer and center it
-        float delayedSample_Centered = (float)delayBuffer[delayReadPointer] - 511.5;
-
-        // The core echo algorithm: new sample in buffer is input + feedback of delayed sample
-        float newSampleForBuffer_Centered = centered_input + (delayedSample_Centered * fixedEchoFeedbackFactor);
-        
-        // Store newSampleForBuffer_Centered back into buffer after re-biasing
-        delayBuffer[delayWritePointer] = (uint16_t)constrain(newSampleForBuffer_Centered + 511.5, 0, 1023);
-
-        // Final output is sum of dry input and delayed signal (for clear echo)
-        outputSampleFloat = centered_input + delayedSample_Centered;
+void restartEcho(){
+    effectState<EchoEffect>().runningMode = CLEAN_MODE;
+}
 
-    } else { // If effect is not active, pass through clean signal
-        outputSampleFloat = centered_input;
-        for (int i = 0; i < MAX_DELAY; i++) { delayBuffer[i] = 0; } // Always clear buffer on bypass
-        delayWritePointer = 0;
-    }
+/**
+ * @brief: Converts the delay time to a line offset. Runs in loop() when a setting changes.
+ */
+void deriveEchoParams(EchoParams &params) {
+    params.delaySamples = DELAY_US_TO_SAMPLES(params.time);
+}
 
-    // Update Delay Buffer Write Pointer
-    delayWritePointer++;
-    if (delayWritePointer >= MAX_DELAY) {
-        delayWritePointer = 0;
+/**
+ * @brief: Audio processing function for Echo effect.
+ * Uses centered Q15 fixed-point math to prevent clipping and buzzing.
+ * @param inputSample The centered Q15 input audio sample.
+ * @return The processed Q15 sample, before master volume.
+ */
+q15_t processEchoAudio(q15_t inputSample) {
+    EchoEffect::State &state = effectState<EchoEffect>();
+    const EchoParams &params = effectParams<EchoEffect>().live();
+
+    // The loop shares these bytes: start from silence when they hold anything else.
+    // Constant time (see delayline.h)
+    if (state.runningMode != ECHO_MODE) {
+        state.delay.clear();
+        state.runningMode = ECHO_MODE;
     }
 
-    // --- Final Output Processing ---
-    // Re-bias the processed sample to 0-1023 range
-    int finalOutputSample = (int)(outputSampleFloat + 511.5);
-
-    // Apply global master volume controlled by PUSHBUTTON_1/2
-    float volume_factor = pot2_value / 1023.0;
-    finalOutputSample = (int)(finalOutputSample * volume_factor);
+    // Get delayed sample from the delay line
+    q15_t delayedSample = state.delay.read(params.delaySamples);
 
-    // Constrain the final output to the valid 10-bit range (0-1023)
-    finalOutputSample = constrain(finalOutputSample, 0, 1023);
+    // The core echo algorithm: new sample in buffer is input + feedback of delayed sample
+    q15_t newSampleForBuffer = q15Add(inputSample, q15Mul(delayedSample, params.feedback));
 
-    // // Split for dual PWM output
-    // analogWrite(AUDIO_OUT_A, finalOutputSample / 4);
-    // analogWrite(AUDIO_OUT_B, map(finalOutputSample % 4, 0, 3, 0, 255));
+    // Store newSampleForBuffer in the delay line and advance it
+    state.delay.write(newSampleForBuffer);
 
-    /*write the PWM output signal*/
-    OCR1AL = ((finalOutputSample + 0x8000) >> 8); // convert to unsigned, send out high byte
-    OCR1BL = finalOutputSample; // send out low byte
+    // Final output is sum of dry input and delayed signal (for clear echo)
+    return q15Add(inputSample, delayedSample);
 }
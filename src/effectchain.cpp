@@ -0,0 +1,73 @@
+#include "effectchain.h"
+#include <Arduino.h>
+
+EffectMode effectChain[EFFECT_CHAIN_MAX];
+uint8_t effectChainLength = 0;
+
+static constexpr EffectMode defaultEffectChain[] = EFFECT_CHAIN_DEFAULT;
+static_assert(effectChainFits(defaultEffectChain, sizeof(defaultEffectChain) / sizeof(defaultEffectChain[0])),
+              "EFFECT_CHAIN_DEFAULT does not fit the ISR cycle budget, names an effect that is not compiled in "
+              "or runs two modes of one effect");
+static_assert(effectModesFit(0), "An effect in ActiveEffects does not fit one sample period at this AUDIO_RATE; drop it or pick a slower rate");
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Loads EFFECT_CHAIN_DEFAULT. This function is called once in setup().
+ */
+void effectChainSetup(void) {
+    effectChainSelect(defaultEffectChain, sizeof(defaultEffectChain) / sizeof(defaultEffectChain[0]));
+}
+
+/**
+ * @brief: Runs one sample through every stage of the selected chain, in order.
+ * Kept out of line: the stage dispatch inlines every kernel, and the flattened ISR would
+ * otherwise copy them all again next to its own dispatch (see main.cpp).
+ * @param inputSample The centered Q15 input audio sample.
+ * @return The processed Q15 sample, before master volume.
+ */
+__attribute__((noinline)) q15_t processEffectChain(q15_t inputSample) {
+    q15_t sample = inputSample;
+    for (uint8_t stage = 0; stage < effectChainLength; stage++) {
+        sample = ActiveEffects::process(effectChain[stage], sample);
+    }
+    return sample;
+}
+
+/**
+ * @brief: Replaces the running chain if it fits the cycle budget and uses every effect once.
+ * The copy is done with interrupts off so the ISR never runs a half-updated chain.
+ * @param modes Stage modes, in processing order.
+ * @param count Number of stages (EFFECT_CHAIN_MIN to EFFECT_CHAIN_MAX).
+ * @return false (and the current chain is kept) if the chain was rejected.
+ */
+bool effectChainSelect(const EffectMode *modes, uint8_t count) {
+    EffectChainStatus status = effectChainCheck(modes, count);
+    if (status != EFFECT_CHAIN_OK) {
+        Serial.print(F("Effect chain rejected: "));
+        switch (status) {
+            case EFFECT_CHAIN_BAD_LENGTH:
+                Serial.print(count); Serial.print(F(" stages, not ")); Serial.print(EFFECT_CHAIN_MIN);
+                Serial.print(F(" to ")); Serial.println(EFFECT_CHAIN_MAX);
+                break;
+            case EFFECT_CHAIN_BAD_STAGE:
+                Serial.println(F("a stage is not an effect in this build"));
+                break;
+            case EFFECT_CHAIN_SHARED:
+                Serial.println(F("two stages share one effect"));
+                break;
+            default:
+                Serial.print(effectChainCycles(modes, count));
+                Serial.print(F(" of ")); Serial.print(EFFECT_CHAIN_BUDGET_CYCLES); Serial.println(F(" cycles"));
+                break;
+        }
+        return false;
+    }
+    uint8_t oldSREG = SREG;
+    cli();
+    for (uint8_t stage = 0; stage < count; stage++) {
+        effectChain[stage] = modes[stage];
+    }
+    effectChainLength = count;
+    SREG = oldSREG;
+    return true;
+}
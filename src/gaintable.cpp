@@ -0,0 +1,11 @@
+/* Generated by tools/gen_gain_table.py - edit the script, not this file.*/
+#include "outputgain.h"
+
+const q15_t outputGainTable[OUTPUT_GAIN_TABLE_POINTS] PROGMEM = {
+    0, 130, 149, 170, 195, 223, 255, 291, 333, 380, 435, 497,
+    568, 649, 742, 848, 969, 1108, 1266, 1447, 1655, 1891, 2162, 2471,
+    2824, 3228, 3690, 4218, 4822, 5511, 6300, 7201, 8231, 8594, 8973, 9369,
+    9783, 10214, 10665, 11135, 11627, 12139, 12675, 13234, 13818, 14428, 15064, 15729,
+    16423, 17147, 17904, 18694, 19519, 20380, 21279, 22218, 23198, 24221, 25290, 26406,
+    27571, 28787, 30057, 31383, 32767,
+};
@@ -0,0 +1,114 @@
+#include "inputs.h"
+
+/*Arduino pin of every InputId. Kept in flash; see main.h for the wiring.*/
+static const uint8_t inputPins[INPUT_COUNT] PROGMEM = {
+    FOOTSWITCH,
+    TOGGLE,
+    PUSHBUTTON_1,
+    PUSHBUTTON_2,
+    SELECT_OCTAVER_BUTTON,
+    SELECT_NORMAL_BUTTON,
+    SELECT_REVERB_BUTTON,
+    SELECT_ECHO_BUTTON,
+    SELECT_DISTORTION_BUTTON,
+    SELECT_SINEWAVE_BUTTON,
+    SELECT_CHAIN_BUTTON,
+    SELECT_MODULATION_BUTTON,
+};
+
+/*ATmega328P (Uno) pin to port mapping: D0-D7 on PORTD, D8-D13 on PORTB, A0-A5 on PORTC*/
+enum { INPUT_PORT_B = 0, INPUT_PORT_C, INPUT_PORT_D };
+static inline uint8_t pinPort(uint8_t pin) { return pin < 8 ? INPUT_PORT_D : (pin < 14 ? INPUT_PORT_B : INPUT_PORT_C); }
+static inline uint8_t pinBit(uint8_t pin) { return pin < 8 ? pin : (pin < 14 ? pin - 8 : pin - 14); }
+
+static uint16_t inputStable;       // Debounced levels, bit per InputId, 1 = pressed
+static uint16_t inputRaw;          // Levels seen on the last poll
+static uint16_t inputChangedAt[INPUT_COUNT]; // millis() (low 16 bits) of each input's last raw change
+static uint16_t pendingPresses;    // Events not yet taken by inputsNextEvent()
+static uint16_t pendingReleases;
+
+static_assert(INPUT_COUNT <= 16, "InputId bits must fit the 16-bit masks");
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Reads every input at once. Bit n is set if InputId n is pressed (pin LOW).
+ */
+static uint16_t readInputPorts(void) {
+    const uint8_t ports[3] = {PINB, PINC, PIND};
+    uint16_t pressed = 0;
+    for (uint8_t input = 0; input < INPUT_COUNT; input++) {
+        uint8_t pin = pgm_read_byte(&inputPins[input]);
+        if (!(ports[pinPort(pin)] & _BV(pinBit(pin)))) {
+            pressed |= (uint16_t)1 << input;
+        }
+    }
+    return pressed;
+}
+
+/**
+ * @brief: Takes the switch positions at boot as the debounced state, without events,
+ * so a switch held at power-up is not reported as a press.
+ * This function is called once in setup(), after pinConfig().
+ */
+void inputsSetup(void) {
+    inputRaw = inputStable = readInputPorts();
+    uint16_t now = (uint16_t)millis();
+    for (uint8_t input = 0; input < INPUT_COUNT; input++) {
+        inputChangedAt[input] = now;
+    }
+    pendingPresses = pendingReleases = 0;
+}
+
+/**
+ * @brief: Samples and debounces all inputs and queues events for accepted changes.
+ * Called on every pass of loop().
+ */
+void inputsPoll(void) {
+    uint16_t raw = readInputPorts();
+    uint16_t now = (uint16_t)millis();
+    uint16_t bouncing = raw ^ inputRaw;
+    inputRaw = raw;
+
+    for (uint8_t input = 0; input < INPUT_COUNT; input++) {
+        uint16_t bit = (uint16_t)1 << input;
+        if (bouncing & bit) {
+            inputChangedAt[input] = now; // Restart the stability window
+        } else if (((raw ^ inputStable) & bit) && (uint16_t)(now - inputChangedAt[input]) >= DEBOUNCE_DELAY_MS) {
+            inputStable ^= bit;
+            if (raw & bit) {
+                pendingPresses |= bit;
+                pendingReleases &= ~bit;
+            } else {
+                pendingReleases |= bit;
+                pendingPresses &= ~bit;
+            }
+        }
+    }
+}
+
+/**
+ * @brief: Takes the next queued event, lowest InputId first.
+ * @return false if no input changed since the last call.
+ */
+bool inputsNextEvent(InputEvent &event) {
+    uint16_t pending = pendingPresses | pendingReleases;
+    if (!pending) return false;
+
+    uint8_t input = 0;
+    while (!(pending & ((uint16_t)1 << input))) input++;
+    uint16_t bit = (uint16_t)1 << input;
+
+    event.input = (InputId)input;
+    event.type = (pendingPresses & bit) ? INPUT_PRESSED : INPUT_RELEASED;
+    pendingPresses &= ~bit;
+    pendingReleases &= ~bit;
+    return true;
+}
+
+/**
+ * @brief: Debounced level of an input.
+ * @return true while the switch is closed.
+ */
+bool inputHeld(InputId input) {
+    return inputStable & ((uint16_t)1 << input);
+}
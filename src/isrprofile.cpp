@@ -0,0 +1,73 @@
+#include "isrprofile.h"
+#include "arena.h"
+#include <Arduino.h>
+
+#ifdef ISR_PROFILE
+IsrProfileStats isrProfileStats[NUM_EFFECTS_ENUM];
+
+static_assert(sizeof(isrProfileStats) <= ISR_PROFILE_SRAM_BYTES + SRAM_HOST_PADDING_BYTES,
+              "isrProfileStats outgrew ISR_PROFILE_SRAM_BYTES (arena.h)");
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Starts Timer2 free-running at ck/8 as the ISR timestamp source.
+ * This function is called once in setup(). Timer2 is otherwise unused
+ * (pins 3 and 11 are digital inputs, not analogWrite outputs).
+ */
+void isrProfileSetup(void) {
+    TCCR2A = 0x00; // Normal mode, OC2A/OC2B disconnected
+    TCCR2B = 0x02; // ck/8
+    isrProfileReset();
+}
+
+/**
+ * @brief: Clears all statistics. Interrupts are held off so the ISR never
+ * sees a half-cleared record.
+ */
+void isrProfileReset(void) {
+    uint8_t oldSREG = SREG;
+    cli();
+    for (uint8_t mode = 0; mode < NUM_EFFECTS_ENUM; mode++) {
+        IsrProfileStats *stats = &isrProfileStats[mode];
+        stats->minTicks = 0xFF;
+        stats->maxTicks = 0;
+        stats->overruns = 0;
+        stats->count = 0;
+        stats->sumTicks = 0;
+        for (uint8_t bin = 0; bin < ISR_PROFILE_HIST_BINS; bin++) {
+            stats->histogram[bin] = 0;
+        }
+    }
+    SREG = oldSREG;
+}
+
+/**
+ * @brief: Prints min/mean/max cycles, overruns and the histogram for every mode
+ * that has run since the last reset. Each mode's record is copied with interrupts
+ * off so the printed values are consistent.
+ */
+void isrProfilePrint(void) {
+    Serial.print(F("ISR profile, budget ")); Serial.print(AUDIO_SAMPLE_PERIOD_CYCLES); Serial.println(F(" cycles/sample"));
+    for (uint8_t mode = 0; mode < NUM_EFFECTS_ENUM; mode++) {
+        IsrProfileStats stats;
+        uint8_t oldSREG = SREG;
+        cli();
+        stats = isrProfileStats[mode];
+        SREG = oldSREG;
+        if (stats.count == 0) {
+            continue;
+        }
+        Serial.print(F("mode ")); Serial.print(mode);
+        Serial.print(F(": n=")); Serial.print(stats.count);
+        Serial.print(F(" min=")); Serial.print((unsigned int)stats.minTicks * ISR_PROFILE_CYCLES_PER_TICK);
+        Serial.print(F(" mean=")); Serial.print((unsigned long)(stats.sumTicks / stats.count) * ISR_PROFILE_CYCLES_PER_TICK);
+        Serial.print(F(" max=")); Serial.print((unsigned int)stats.maxTicks * ISR_PROFILE_CYCLES_PER_TICK);
+        Serial.print(F(" overruns=")); Serial.print(stats.overruns);
+        Serial.print(F(" hist[256cyc]="));
+        for (uint8_t bin = 0; bin < ISR_PROFILE_HIST_BINS; bin++) {
+            Serial.print(stats.histogram[bin]);
+            Serial.print(bin + 1 < ISR_PROFILE_HIST_BINS ? ',' : '\n');
+        }
+    }
+}
+#endif
@@ -0,0 +1,43 @@
+#include "lfo.h"
+#include "sinewave.h"
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Waveform value at a phase, full scale.
+ */
+static q15_t lfoShapeAt(uint8_t shape, uint16_t phase) {
+    if (shape == LFO_TRIANGLE) {
+        // Rises over the first half of the cycle, falls over the second
+        uint16_t ramp = (phase & 0x8000) ? (uint16_t)~phase : phase; // 0..0x7FFF
+        return (q15_t)((ramp << 1) - 0x7FFF);
+    }
+    const q15_t *entry = &sineTable[phase >> 8];
+    q15_t sample1 = (q15_t)pgm_read_word(entry);
+    q15_t sample2 = (q15_t)pgm_read_word(entry + 1);
+    return sample1 + (q15_t)((((int32_t)sample2 - sample1) * (uint8_t)phase) >> 8);
+}
+
+/**
+ * @brief: Restarts an LFO at phase 0 with a new shape and rate. Called by the owning
+ * effect, from the ISR when its mode starts, so no locking is needed.
+ * @param step Phase step per control-rate update, see LFO_STEP().
+ */
+void lfoStart(Lfo &lfo, LfoShape shape, uint16_t step) {
+    lfo.shape = shape;
+    lfo.step = step;
+    lfo.phase = 0;
+    lfo.value = lfoShapeAt(shape, 0);
+    lfo.increment = 0;
+    lfo.countdown = 1; // Compute the first ramp on the next tick
+}
+
+/**
+ * @brief: Control-rate update: steps the phase and sets the ramp to the next point.
+ * Both terms are shifted before subtracting so the difference fits 16 bits.
+ */
+void lfoAdvance(Lfo &lfo) {
+    lfo.phase += lfo.step;
+    q15_t target = lfoShapeAt(lfo.shape, lfo.phase);
+    lfo.increment = (target >> LFO_DECIMATION_LOG2) - (lfo.value >> LFO_DECIMATION_LOG2);
+    lfo.countdown = 1 << LFO_DECIMATION_LOG2;
+}
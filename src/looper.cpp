@@ -0,0 +1,140 @@
+#include "effects.h"
+#include <Arduino.h>
+
+static_assert(sizeof(Looper) <= sizeof(DelayLine<ECHO_DELAY_BITS, ECHO_DELAY_SIZE_LOG2>),
+              "The loop takes the echo line's arena bytes; lower LOOPER_CODE_BYTES (echo.h) to fit them");
+static_assert(LOOPER_SLOTS < 65535U, "Slot positions are 16-bit");
+static_assert(LOOPER_MIN_SLOTS > 0 && LOOPER_MIN_SLOTS < LOOPER_SLOTS, "LOOPER_MIN_MS must fit in the loop memory");
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Drops the loop and any pending request, and starts the first take. Constant
+ * time: slots past the loop length are never decoded, so the old codes need no clearing.
+ */
+void restartLooper(void) {
+    Looper &looper = effectState<EchoEffect>().looper;
+    effectState<EchoEffect>().looperRequest = LOOPER_REQUEST_NONE;
+    adpcmReset(looper.encoder);
+    adpcmReset(looper.decoder);
+    looper.position = 0;
+    looper.length = 0;
+    looper.sum = 0;
+    looper.previous = 0;
+    looper.current = 0;
+    looper.subSample = 0;
+    looper.phase = LOOPER_RECORDING;
+}
+
+/**
+ * @brief: Closes the first take at the current slot, or toggles overdub. Called from loop()
+ * (echo button in LOOPER_MODE); takes effect at the next stored sample.
+ */
+void looperPress(void) {
+    effectState<EchoEffect>().looperRequest = LOOPER_REQUEST_PRESS;
+}
+
+/**
+ * @brief: Drops the loop and records a new first take from the next stored sample.
+ * Called from loop() (TOGGLE in LOOPER_MODE).
+ */
+void looperRecordAgain(void) {
+    effectState<EchoEffect>().looperRequest = LOOPER_REQUEST_RECORD_AGAIN;
+}
+
+/**
+ * @brief: Drops a request the ISR has not taken yet. Called from loop() when the
+ * running mode leaves LOOPER_MODE, so a press does not act when the loop resumes.
+ */
+void looperCancelRequest(void) {
+    effectState<EchoEffect>().looperRequest = LOOPER_REQUEST_NONE;
+}
+
+/**
+ * @brief: Acts on a request from loop(). Runs in the ISR between two slots, after
+ * position has moved past the slot just stored.
+ */
+static inline void looperTakeRequest(Looper &looper) {
+    volatile uint8_t &pending = effectState<EchoEffect>().looperRequest;
+    uint8_t request = pending;
+    if (request == LOOPER_REQUEST_NONE) return;
+    pending = LOOPER_REQUEST_NONE;
+    if (request == LOOPER_REQUEST_PRESS && looper.phase == LOOPER_RECORDING && looper.position < LOOPER_MIN_SLOTS) {
+        return; // Take too short to loop: the press is dropped and recording goes on
+    }
+    if (request == LOOPER_REQUEST_RECORD_AGAIN) {
+        looper.length = 0;
+        looper.position = 0;
+        adpcmReset(looper.encoder);
+        looper.phase = LOOPER_RECORDING;
+    } else if (looper.phase == LOOPER_RECORDING) {
+        looper.length = looper.position; // Wraps below
+        looper.phase = LOOPER_PLAYING;
+    } else {
+        looper.phase = (looper.phase == LOOPER_PLAYING) ? LOOPER_OVERDUBBING : LOOPER_PLAYING;
+    }
+}
+
+/**
+ * @brief: Moves one slot on: reads the stored sample for playback and writes it back with
+ * the summed input added while recording or overdubbing. Runs once every
+ * LOOPER_DECIMATION samples; one decode and one encode whatever the phase.
+ */
+static inline void looperStep(Looper &looper) {
+    uint8_t *packed = &looper.codes[looper.position >> 1];
+    uint8_t shift = (looper.position & 1) << 2;
+
+    q15_t stored = 0; // The first take has nothing to play yet
+    if (looper.length) {
+        stored = adpcmDecode(looper.decoder, (*packed >> shift) & 0x0F);
+    }
+    looper.previous = looper.current;
+    looper.current = stored;
+
+    if (looper.phase != LOOPER_PLAYING) {
+        stored = q15Add(stored, looper.sum);
+    }
+    uint8_t code = adpcmEncode(looper.encoder, stored);
+    *packed = (*packed & (0xF0 >> shift)) | (code << shift);
+    looper.sum = 0;
+
+    looper.position++;
+    looperTakeRequest(looper);
+    if (looper.length == 0 && looper.position == LOOPER_SLOTS) {
+        looper.length = LOOPER_SLOTS; // Memory full: the first take closes itself
+        looper.phase = LOOPER_PLAYING;
+    }
+    if (looper.length && looper.position >= looper.length) {
+        // Both coders start the next pass from silence, as the encoder did on this one
+        looper.position = 0;
+        adpcmReset(looper.encoder);
+        adpcmReset(looper.decoder);
+    }
+}
+
+/**
+ * @brief: Audio processing function for LOOPER_MODE.
+ * The input passes through dry with the loop added; the loop is stepped once every
+ * LOOPER_DECIMATION samples (looperStep()) and interpolated in between.
+ * @param inputSample The centered Q15 input audio sample.
+ * @return The processed Q15 sample, before master volume.
+ */
+q15_t processLooperAudio(q15_t inputSample) {
+    EchoEffect::State &state = effectState<EchoEffect>();
+    Looper &looper = state.looper;
+
+    // The echo line shares these bytes: start the first take when they hold anything else
+    if (state.runningMode != LOOPER_MODE) {
+        restartLooper();
+        state.runningMode = LOOPER_MODE;
+    }
+
+    looper.sum += inputSample >> LOOPER_DECIMATION_LOG2;
+    if (++looper.subSample == LOOPER_DECIMATION) {
+        looper.subSample = 0;
+        looperStep(looper);
+    }
+
+    q15_t played = looper.previous +
+                   (q15_t)((((int32_t)looper.current - looper.previous) * looper.subSample) >> LOOPER_DECIMATION_LOG2);
+    return q15Add(inputSample, played);
+}
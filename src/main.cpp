@@ -1,224 +1,211 @@
 #include "main.h"
-#include "reverb.h"
-#include "echo.h"
-#include "octaver.h"
-#include "distortion.h"
-#include "sinewave.h"
+#include "effects.h"
+#include "effectchain.h"
+#include "audioblock.h"
+#include "isrprofile.h"
+#include "telemetry.h"
+#include "serialcommands.h"
+#include "inputs.h"
+#include "preset.h"
+#include "outputgain.h"
+#include "transition.h"
+#include "benchmark.h"
+#include "sampleio.h"
 
-int input_raw_sample;
-uint8_t ADC_low, ADC_high;
+q15_t input_raw_sample;
 
-uint16_t delayBuffer[MAX_DELAY]; 
-uint32_t delayWritePointer = 0;
-uint32_t delayReadOffset;
-uint32_t delayDepth;
 
-int counter = 0; // For volume control logic
-
-volatile int pot2_value = 512; // Initialized to mid-range (0-1023)
+int pot2_value = 512; // Initialized to mid-range (0-1024)
 
 volatile bool effectActive = false; 
 volatile EffectMode currentActiveMode = NORMAL_MODE; // Initially set, will be updated by setup
 volatile EffectMode lastSelectedMode = NORMAL_MODE;  // Stores the last non-CLEAN effect mode
 
-/*Initializing debouncing Variables. Currently not used*/
-volatile unsigned long lastFootswitchPressTime = 0;
-volatile unsigned long lastToggleSwitchStateChange = 0;
+/*Debouncing: a switch must hold a new level this long before it counts (see inputs.h)*/
 const unsigned long DEBOUNCE_DELAY_MS = 100;
-volatile unsigned long lastPushButton1PressTime = 0;
-volatile unsigned long lastPushButton2PressTime = 0;
-volatile unsigned long lastSelectNormalPressTime = 0;
-volatile unsigned long lastSelectEffectButtonA2PressTime = 0;
-volatile unsigned long lastSelectOctaverPressTime = 0;
-
-/* Counter to periodically check pushbuttons (for volume control) */
-volatile int button_check_counter = 0;
-const int BUTTON_CHECK_INTERVAL = 100;
+const unsigned long VOLUME_REPEAT_MS = 5; // Volume step interval while a volume button is held
 
-const long SAMPLE_RATE_MICROS = 50;
+static void handleInputEvent(const InputEvent &event);
 
 void setup() {
-    Serial.begin(9600);
+    Serial.begin(SERIAL_BAUD);
 
     pinConfig(); // Configure all I/O pins
+    inputsSetup(); // Take the current switch positions as the starting state
     adcSetup();  // Configure ADC
-    pmwSetup();  // Configure PWM and Timer1 ISR
-
-    for (int i = 0; i < MAX_DELAY; i++) {
-        delayBuffer[i] = 0;
-    }
-    // Initialize specific effect modules
-    #ifdef OCTAVER
-    setupOctaver();
-    lastSelectedMode = OCTAVER_MODE;
+    #ifdef AUDIO_BLOCK_MODE
+    audioBlockSetup(); // Prime the ping-pong blocks before the ISR starts using them
     #endif
-
-    #ifdef REVERB
-    setUpReverb();
-    lastSelectedMode = REVERB_ECHO_MODE; 
-    #endif
-
-    #ifdef ECHO
-    setupEcho();
-    lastSelectedMode = ECHO_MODE;
+    #ifdef ISR_PROFILE
+    isrProfileSetup(); // Start the Timer2 timestamp source before the ISR runs
     #endif
-
-    #ifdef DISTORTION
-    setupDistortion();
-    lastSelectedMode = DISTORTION_MODE;
+    #ifdef TELEMETRY
+    telemetrySetup(); // Empty the record ring before the ISR starts filling it
     #endif
+    pmwSetup();  // Configure PWM and Timer1 ISR
 
-    #ifdef SINEWAVE
-    setupSinewave();
-    lastSelectedMode = SINEWAVE_MODE;
+    // Initialize the effect modules compiled into ActiveEffects (effects.h)
+    ActiveEffects::paramsSetupAll(effectParamBanks); // Parameter table defaults (params.h)
+    ActiveEffects::setupAll();
+    effectChainSetup();
+    arenaReport();
+    Serial.print(F("Sample rate: ")); Serial.print((unsigned long)(AUDIO_SAMPLE_RATE_HZ + 0.5));
+    Serial.print(F(" Hz, ")); Serial.print(AUDIO_SAMPLE_PERIOD_CYCLES); Serial.println(F(" cycles per sample"));
+    #ifdef BENCHMARK
+    benchmarkSetup(); // Declared cycles per mode, for tools/benchmark.py
     #endif
 
     lastSelectedMode = NORMAL_MODE; 
+    setMasterVolume(pot2_value); // Fades in from mute (outputgain.h)
     // Initial state after setup: go to lastSelectedMode unless FOOTSWITCH is pressed for CLEAN
-    currentActiveMode = lastSelectedMode;
-    effectActive = true; // Assume effect is active initially, can be overridden by footswitch
-
-    Serial.println("Arduino Audio Pedal Ready!");
+    effectActive = !inputHeld(INPUT_FOOTSWITCH);
+    transitionSetup(effectActive ? lastSelectedMode : CLEAN_MODE); // No fade at boot
+    digitalWrite(LED_EFFECT_ON, effectActive ? HIGH : LOW);
+    // Last-used mode, volume and parameters from EEPROM (preset.h). Runs once the mode state
+    // is set up, so the restored mode is selected like a preset load and nothing resets it;
+    // its fade runs under the fade-in from mute.
+    presetSetup();
+
+    Serial.println(F("Arduino Audio Pedal Ready!"));
 }
 
 void loop() {
-    /* --- Momentary Global Bypass (FOOTSWITCH) ---
-       FOOTSWITCH is pressed (LOW), force CLEAN_MODE. Otherwise, run the last selected effect*/
-    if (digitalRead(FOOTSWITCH) == LOW) { // FOOTSWITCH IS PRESSED
-        Serial.print("Footswitch: "); Serial.println(digitalRead(FOOTSWITCH));
-        currentActiveMode = CLEAN_MODE; // Force bypass
-        Serial.print("currentActiveMode: "); Serial.println(currentActiveMode);
-        effectActive = false; // Indicate effect is not active
-        Serial.print("effectActive: "); Serial.println(effectActive);
-        digitalWrite(LED_EFFECT_ON, LOW); // LED OFF when in clean mode via footswitch
-        Serial.println("Footswitch pressed, LED OFF");
-    } 
-    else { // FOOTSWITCH IS NOT PRESSED (HIGH)
-        currentActiveMode = lastSelectedMode; // Revert to last selected effect
-        effectActive = true; // Indicate effect is active
-        Serial.print("effectActive: "); Serial.println(effectActive);
-        digitalWrite(LED_EFFECT_ON, HIGH); // LED ON when effect is active
-        Serial.println("Footswitch released, LED ON");
+    #ifdef BENCHMARK
+    benchmarkService(); // Scripted mode walk; the simulator leaves the switches floating
+    #else
+    // Debounced switch changes drive the mode state machine; nothing is rewritten
+    // or printed on passes where no input changed.
+    inputsPoll();
+    InputEvent event;
+    while (inputsNextEvent(event)) {
+        handleInputEvent(event);
     }
+    #endif
 
-     volumeControl(); // Check volume control push-buttons every 100 iterations
-
-    /*EFFECT SELECTION */
-    // These buttons override the FOOTSWITCH if pressed*/
-    bool buttonA3Pressed = (digitalRead(SELECT_OCTAVER_BUTTON) == LOW);
-    bool buttonA4Pressed = (digitalRead(SELECT_NORMAL_BUTTON) == LOW);
-    bool buttonA5Pressed = (digitalRead(SELECT_REVERB_BUTTON) == LOW);
-    bool button2Pressed = (digitalRead(SELECT_ECHO_BUTTON) == LOW);
-    bool button3Pressed = (digitalRead(SELECT_DISTORTION_BUTTON) == LOW);
-    bool button4Pressed = (digitalRead(SELECT_SINEWAVE_BUTTON) == LOW);
-
-    // If any selection button is pressed, it takes precedence over FOOTSWITCH and activates its effect momentarily.
-    if (buttonA3Pressed || buttonA4Pressed || buttonA5Pressed || button2Pressed || button3Pressed) {
-        
-        // Handle octaver mode selection
-        if (buttonA3Pressed) {
-            Serial.println("A3 Pressed");
-            #ifdef OCTAVER
-            lastSelectedMode = OCTAVER_MODE;
-            Serial.println("Momentary Mode: OCTAVER");
-            currentActiveMode = OCTAVER_MODE;
-            #endif
-            effectActive = true;
-            digitalWrite(LED_EFFECT_ON, HIGH);
-        }
+    transitionService(); // Starts a mode change that had to wait for the previous one (transition.h)
 
-        //Handle normal mode selection
-        if (buttonA4Pressed ) {
-            Serial.println("A4 Pressed");
-            lastSelectedMode = NORMAL_MODE; // Set as last selected
-            Serial.println("Momentary Mode: NORMAL");
-            currentActiveMode = NORMAL_MODE;
-            effectActive = true;
-            digitalWrite(LED_EFFECT_ON, HIGH);
-        }
-        
-         //Handle reverb_echo mode selection
-        if (buttonA5Pressed ) {
-            Serial.println("A5 Pressed");
-            lastSelectedMode = REVERB_ECHO_MODE; // Set as last selected
-            Serial.println("Momentary Mode: REVERB_ECHO");
-            currentActiveMode = REVERB_ECHO_MODE;
-            effectActive = true;
-            digitalWrite(LED_EFFECT_ON, HIGH);
-        }
-        
-         //Handle echo mode selection
-        if (button2Pressed ) {
-            Serial.println("2 Pressed");
-            lastSelectedMode = ECHO_MODE; // Set as last selected
-            Serial.println("Momentary Mode: ECHO");
-            currentActiveMode = ECHO_MODE;
-            effectActive = true;
-            digitalWrite(LED_EFFECT_ON, HIGH);
-        }
+    volumeControl(); // Volume push-buttons, auto-repeat while held
 
-        // Handle distortion mode selection
-        if (button3Pressed) {
-            Serial.println("3 Pressed");
-            lastSelectedMode = DISTORTION_MODE;
-            Serial.println("Momentary Mode: DISTORTION");
-            currentActiveMode = DISTORTION_MODE;
-            effectActive = true;
-            digitalWrite(LED_EFFECT_ON, HIGH);
-        }
+    serialCommandsPoll(); // Console commands (serialcommands.h)
 
-        // Handle sinewave mode selection
-        if (button4Pressed) {
-            Serial.println("4 Pressed");
-            lastSelectedMode = SINEWAVE_MODE;
-            Serial.println("Momentary Mode: SINEWAVE");
-            currentActiveMode = SINEWAVE_MODE;
-            effectActive = true;
-            digitalWrite(LED_EFFECT_ON, HIGH);
-        }
+    presetService(); // Saves the last-used state once it settles, a byte at a time (preset.h)
 
-        // When any effect selection button is pressed, always clear delay buffer
-        // to prevent sound artifacts from previous modes.
-        for (int i = 0; i < MAX_DELAY; i++) {
-            delayBuffer[i] = 0;
-        }
-        delayWritePointer = 0;
+    #ifdef TELEMETRY
+    telemetryService(); // Streams queued records while the transmit buffer has room
+    #endif
 
-    } 
-    else { // No effect selection button is pressed
-        // If no momentary button is pressed, effectActive and currentActiveMode
-        // are determined by the FOOTSWITCH state, as set at the start of loop().
-        // Nothing to do here explicitly, as it was handled already.
-    }
+    // --- Effect-specific loop functions ---
+    // Non-time-critical logic specific to the effect serving the current mode.
+    ActiveEffects::loop(currentActiveMode);
+}
+
+/**
+ * @brief: Mode the TOGGLE switch selects for the reverb module: up (open) for
+ * REVERB_ECHO_MODE, down (closed) for DELAY_MODE.
+ */
+static EffectMode reverbToggleMode(void) {
+    return inputHeld(INPUT_TOGGLE) ? DELAY_MODE : REVERB_ECHO_MODE;
+}
 
+/**
+ * @brief: Selects mode as the last selected effect, if it is compiled in.
+ * @return false if the effect is not in ActiveEffects (the button is ignored).
+ */
+static bool selectMode(EffectMode mode) {
+    if (mode != CHAIN_MODE && !ActiveEffects::enabled(mode)) return false;
+    lastSelectedMode = mode;
+    return true;
+}
 
-    // --- Effect-specific loop functions ---
-    // These functions now primarily handle sub-mode selection (like REVERB's TOGGLE)
-    // and any other non-time-critical logic specific to their effect.
-    // They are called only if their respective #define is active.
-    #ifdef REVERB
-    // If the current active mode is a REVERB sub-mode (set by A2 or lastSelectedMode),
-    // then allow its loop function to manage its internal TOGGLE switch.
-    if (currentActiveMode == REVERB_ECHO_MODE || currentActiveMode == DELAY_MODE) {
-        loopReverb();
-    }
-    #elif defined(ECHO)
-    if (currentActiveMode == ECHO_MODE) {
-        loopEcho();
+/**
+ * @brief: Derives the running mode from the selection and the switches held right now.
+ * FOOTSWITCH is a momentary bypass to CLEAN_MODE; holding a selection button overrides
+ * it, as on the original pedal. Only acts and reports when the result changes; the
+ * switch itself is a crossfade run by the ISR (transition.h).
+ */
+static void applyActiveMode(void) {
+    bool selectHeld = false;
+    for (uint8_t input = INPUT_SELECT_OCTAVER; input <= INPUT_SELECT_MODULATION; input++) {
+        selectHeld |= inputHeld((InputId)input);
     }
-    #elif defined(OCTAVER)
-    if (currentActiveMode == OCTAVER_MODE) {
-        loopOctaver();
+    bool active = !inputHeld(INPUT_FOOTSWITCH) || selectHeld;
+    EffectMode mode = active ? lastSelectedMode : CLEAN_MODE;
+
+    if (mode == transitionTarget() && active == effectActive) return;
+    if (mode != LOOPER_MODE) looperCancelRequest(); // A press must not act when the loop resumes
+    transitionTo(mode);
+    effectActive = active;
+    digitalWrite(LED_EFFECT_ON, active ? HIGH : LOW);
+    Serial.print(F("Mode: ")); Serial.println((int)mode);
+}
+
+/**
+ * @brief: Selects mode and updates the running mode, as a selection button would.
+ * Used to restore presets (preset.h).
+ * @return false if the effect is not in ActiveEffects.
+ */
+bool selectEffectMode(EffectMode mode) {
+    if (!selectMode(mode)) return false;
+    applyActiveMode();
+    return true;
+}
+
+/**
+ * @brief: Mode state machine. Runs once per debounced press or release.
+ */
+static void handleInputEvent(const InputEvent &event) {
+    if (event.type == INPUT_PRESSED) {
+        switch (event.input) {
+            case INPUT_SELECT_OCTAVER: selectMode(OCTAVER_MODE); break;
+            case INPUT_SELECT_NORMAL:  selectMode(NORMAL_MODE); break;
+            case INPUT_SELECT_REVERB:  selectMode(reverbToggleMode()); break;
+            case INPUT_SELECT_SINEWAVE: selectMode(SINEWAVE_MODE); break;
+            case INPUT_SELECT_CHAIN:   selectMode(CHAIN_MODE); break;
+
+            case INPUT_SELECT_DISTORTION:
+                // Pressing again while DISTORTION is selected steps to the next waveshaper curve
+                if (lastSelectedMode == DISTORTION_MODE) {
+                    distortionNextCurve();
+                }
+                selectMode(DISTORTION_MODE);
+                break;
+
+            case INPUT_SELECT_ECHO:
+                // Pressing again while ECHO is selected starts the looper; further presses
+                // close its first take and then toggle overdub (looper.h)
+                if (lastSelectedMode == LOOPER_MODE) {
+                    looperPress();
+                } else if (lastSelectedMode == ECHO_MODE) {
+                    selectMode(LOOPER_MODE);
+                } else {
+                    selectMode(ECHO_MODE);
+                }
+                break;
+
+            case INPUT_SELECT_MODULATION:
+                // CHORUS first; each further press steps to FLANGER, VIBRATO, TREMOLO and back
+                if (ModulationEffect::handles(lastSelectedMode)) {
+                    selectMode((lastSelectedMode == TREMOLO_MODE) ? CHORUS_MODE : (EffectMode)(lastSelectedMode + 1));
+                } else {
+                    selectMode(CHORUS_MODE);
+                }
+                break;
+
+            default:
+                break;
+        }
     }
-    #elif defined(DISTORTION)
-    if (currentActiveMode == DISTORTION_MODE) {
-        loopDistortion();
+
+    // The TOGGLE switch flips the reverb module between its sub-modes while it is selected
+    if (event.input == INPUT_TOGGLE && (lastSelectedMode == REVERB_ECHO_MODE || lastSelectedMode == DELAY_MODE)) {
+        selectMode(reverbToggleMode());
     }
-    #elif defined(SINEWAVE)
-    if (currentActiveMode == SINEWAVE_MODE) {
-        loopSinewave();
+    // and records a new loop, flipped either way, while the looper is selected
+    if (event.input == INPUT_TOGGLE && lastSelectedMode == LOOPER_MODE) {
+        looperRecordAgain();
     }
-    #endif
+
+    applyActiveMode();
 }
 
 /**
@@ -226,74 +213,87 @@ void loop() {
  * This ISR is responsible for reading the ADC at a consistent high frequency
  * and then dispatching the raw audio sample to the currently active effect's
  * processing function. This ensures real-time performance regardless of the effect.
+ * The dispatch is generated by ActiveEffects (effects.h), or runs the effect chain in
+ * CHAIN_MODE (effectchain.h), and the ISR is flattened so the
+ * kernels are inlined (across files through LTO) rather than called. Only this direct
+ * dispatch is flattened: the chain and the transition paths are noinline and call the
+ * out-of-line processAudioSample(), so the kernels exist in the ISR, in processAudioSample()
+ * and in processEffectChain() instead of once per call site.
+ * With AUDIO_BLOCK_MODE the ISR only exchanges samples with the ping-pong blocks
+ * and the effect runs once per block (see audioblock.h).
  */
+#ifdef AUDIO_BLOCK_MODE
 ISR(TIMER1_CAPT_vect)
+#else
+ISR(TIMER1_CAPT_vect, __attribute__((flatten)))
+#endif
 {
-    /* Low byte must be fetched first. Read the 10-bit ADC input signal data. */
-    ADC_low = ADCL;
-    ADC_high = ADCH;
-    /* Construct the 10-bit input sample (0-1023) from ADC high and low bytes. */
-    input_raw_sample = ((ADC_high << 8) | ADC_low) + 0x8000; // Ensure ADCL is used correctly
-    /*Apply master volume control to the raw input sample*/
-    input_raw_sample = map(input_raw_sample, 0, 1024, 0, pot2_value);
-    // Dispatch the input sample to the active effect's audio processing function
-    switch (currentActiveMode) {
-        case NORMAL_MODE:
-            processNormalAudio(input_raw_sample);
-            break;
-        case REVERB_ECHO_MODE:
-        case DELAY_MODE:
-            processReverbAudio(input_raw_sample);
-            break;
-        case ECHO_MODE:
-            processEchoAudio(input_raw_sample);
-            break;
-        case OCTAVER_MODE:
-            processOctaverAudio(input_raw_sample);
-            break;
-        case DISTORTION_MODE:
-            processDistortionAudio(input_raw_sample);
-            break;
-        case SINEWAVE_MODE:
-            processSinewaveAudio(input_raw_sample); // Pass raw input, though generator may ignore
-            break;
-        case CLEAN_MODE: // Explicit CLEAN_MODE selected via effect bypass logic or momentary release
-        default:
-        // Simple pass-through. Apply master volume here too for consistency.
-        int output_val_clean = input_raw_sample;
-        output_val_clean = (int)(output_val_clean * (pot2_value / 1023.0));
-        output_val_clean = constrain(output_val_clean, 0, 1023);
-        /*write the PWM output signal*/
-        OCR1AL = ((output_val_clean + 0x8000) >> 8); // convert to unsigned, send out high byte
-        OCR1BL = output_val_clean; // send out low byte
-        // analogWrite(AUDIO_OUT_A, output_val_clean / 4);
-        // analogWrite(AUDIO_OUT_B, map(output_val_clean % 4, 0, 3, 0, 255));
-            break;
+    ISR_PROFILE_ENTER();
+    /* Read the centered Q15 input sample from the ADC (or the host backend, see sampleio.h). */
+    input_raw_sample = sampleIoRead();
+    EffectMode mode = currentActiveMode;
+#ifdef AUDIO_BLOCK_MODE
+    q15_t output_sample = outputGainApply(audioBlockExchange(input_raw_sample));
+    sampleIoWrite(output_sample);
+    TELEMETRY_RECORD(mode, input_raw_sample, output_sample);
+    ISR_PROFILE_EXIT(mode); // Sample exchange only, block processing is preemptible
+    audioBlockService(); // Processes a completed block with interrupts re-enabled
+#else
+    // Dispatch the input sample to the active effect's audio processing function (crossfaded
+    // with the outgoing one during a mode change), then apply the master volume once at the output
+    q15_t output_sample = outputGainApply(transitionProcess(mode, input_raw_sample));
+    sampleIoWrite(output_sample);
+    TELEMETRY_RECORD(mode, input_raw_sample, output_sample);
+    ISR_PROFILE_EXIT(mode);
+#endif
+}
+
+/**
+ * @brief: Runs one sample through the effect selected by mode.
+ * @param mode The effect mode to dispatch to.
+ * @param inputSample The centered Q15 input audio sample.
+ * @return The processed Q15 sample, before master volume.
+ */
+q15_t processAudioSample(EffectMode mode, q15_t inputSample) {
+    if (mode == CHAIN_MODE) {
+        return processEffectChain(inputSample);
+    }
+    return ActiveEffects::process(mode, inputSample);
+}
+
+/**
+ * @brief: Block counterpart of processAudioSample(): dispatches once per block.
+ * @param mode The effect mode to dispatch to.
+ * @param in Centered Q15 input samples.
+ * @param out Receives the processed samples, before master volume.
+ * @param count Number of samples in the block.
+ */
+void processAudioBlock(EffectMode mode, const q15_t *in, q15_t *out, uint8_t count) {
+    if (transition.phase != TRANSITION_IDLE) {
+        for (uint8_t i = 0; i < count; i++) {
+            out[i] = transitionRun(mode, in[i]); // Per sample until the transition ends
+        }
+        return;
+    }
+    if (mode == CHAIN_MODE) {
+        for (uint8_t i = 0; i < count; i++) {
+            out[i] = processEffectChain(in[i]);
+        }
+        return;
     }
+    ActiveEffects::processBlock(mode, in, out, count);
 }
 
 /**
  * @brief: Audio processing function for NORMAL mode.
  * This function provides a simple pass-through signal.
- * It is called by the universal ISR (TIMER1_CAPT_vect).
- * @param input_val The raw 10-bit input audio sample (0-1023).
+ * It is called through the ActiveEffects dispatch (NormalEffect in effects.h).
+ * @param input_val The centered Q15 input audio sample.
+ * @return The unmodified sample; master volume is applied by the shared output stage.
  */
-void processNormalAudio(int input_val) {
-    // For NORMAL_MODE, we simply pass the signal through and apply volume.
-    // No complex DSP or centering needed if it's just bypass with volume.
-    int output_val = input_val;
-
-    // Apply master volume controlled by PUSHBUTTON_1/2
-    output_val = (int)(output_val * (pot2_value / 1023.0));
-
-    // Constrain the output to the valid 10-bit range (0-1023)
-    output_val = constrain(output_val, 0, 1023);
-    // /* Write the PWM output signal using the 10-bit to dual 8-bit PWM technique */
-    // analogWrite(AUDIO_OUT_A, output_val / 4); // Coarse 8 bits (MSB)
-    // analogWrite(AUDIO_OUT_B, map(output_val % 4, 0, 3, 0, 255)); // Fine 2 bits (LSB)
-    /*write the PWM output signal*/
-    OCR1AL = ((output_val + 0x8000) >> 8); // convert to unsigned, send out high byte
-    OCR1BL = output_val; // send out low byte
+q15_t processNormalAudio(q15_t input_val) {
+    // For NORMAL_MODE, we simply pass the signal through.
+    return input_val;
 }
 
 
@@ -315,12 +315,16 @@ void pinConfig (void){
     pinMode(SELECT_ECHO_BUTTON, INPUT_PULLUP);
     pinMode(SELECT_DISTORTION_BUTTON, INPUT_PULLUP);
     pinMode(SELECT_SINEWAVE_BUTTON, INPUT_PULLUP);
+    pinMode(SELECT_CHAIN_BUTTON, INPUT_PULLUP);
+    pinMode(SELECT_MODULATION_BUTTON, INPUT_PULLUP);
 
     // Configure audio input and output pins
     pinMode(AUDIO_OUT_A, OUTPUT); //PWM0 as output
     pinMode(AUDIO_OUT_B, OUTPUT); //PWM1 as output
 
     pinMode(LED_EFFECT_ON, OUTPUT);
+
+    ActiveEffects::pinConfigAll(); // Effect-specific pins, if any
 }
 
 /**
@@ -330,7 +334,7 @@ void pinConfig (void){
  */
 void adcSetup(void){
     ADMUX = 0x60;  // ADMUX: Reference (AVcc), Left Adjust Result, ADC0 (A0) selected
-    ADCSRA = 0xe5; // ADCSRA: ADC Enable, ADC Start Conversion, ADC Auto Trigger Enable, Prescaler CK/32
+    ADCSRA = 0xe0 | ADC_PRESCALER_LOG2; // ADCSRA: ADC Enable, ADC Start Conversion, ADC Auto Trigger Enable, Prescaler (see main.h)
     ADCSRB = 0x07; // ADCSRB: ADC Auto Trigger Source: Timer/Counter1 Capture Event
     DIDR0 = 0x01;  // DIDR0: Disable Digital Input Buffer for ADC0 (A0) to reduce noise.
 }
@@ -361,22 +365,30 @@ void pmwSetup(void){
 }
 
 /**
- * @brief: Periodically checks the volume control push-buttons (PUSHBUTTON_1 and PUSHBUTTON_2).
- * This function is called in the main loop to adjust the global volume (pot2_value).
- * It uses a counter to limit checks to every 100 iterations for efficiency.
+ * @brief: Steps the global volume (pot2_value) while PUSHBUTTON_1 (up) or PUSHBUTTON_2
+ * (down) is held, one step every VOLUME_REPEAT_MS, so the ramp speed does not depend on
+ * how fast loop() runs. Uses the debounced levels from the input manager.
  */
 void volumeControl(void) {
-    // The push-buttons are checked now:
-counter++; //to save resources, the push-buttons are checked every 50 times.
-if(counter==50)
-{
-counter=0;
-if (!digitalRead(PUSHBUTTON_1)) {
-  if (pot2_value<1024) pot2_value=pot2_value+1; //increase the vol
-    }
-if (!digitalRead(PUSHBUTTON_2)) {
-  if (pot2_value>0) pot2_value=pot2_value-1; //decrease vol
+    static unsigned long lastStep = 0;
+    if (millis() - lastStep < VOLUME_REPEAT_MS) return;
+    lastStep = millis();
+
+    if (inputHeld(INPUT_VOLUME_UP)) {
+        if (pot2_value < 1024) pot2_value = pot2_value + 1; //increase the vol
+    } else if (inputHeld(INPUT_VOLUME_DOWN)) {
+        if (pot2_value > 0) pot2_value = pot2_value - 1; //decrease vol
+    } else {
+        return;
     }
-}
+    outputGainSetVolume(pot2_value, false); // Table lookup here, the ISR only ramps and multiplies
 }
 
+/**
+ * @brief: Sets the global volume (0-1024) directly, e.g. from a preset (preset.h).
+ * The output gain ramps to the new level.
+ */
+void setMasterVolume(int volume) {
+    pot2_value = constrain(volume, 0, 1024);
+    outputGainSetVolume(pot2_value, false);
+}
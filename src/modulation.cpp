@@ -0,0 +1,140 @@
+#include "modulation.h"
+#include "effects.h"
+#include <Arduino.h>
+
+/*Delays are in 8.8 fixed point samples (256 = one sample), so the LFO can move them by
+ * fractions of a sample. Center + depth must stay below MODULATION_DELAY_SIZE - 1.*/
+#define MODULATION_DELAY_Q8(ms) ((uint32_t)((ms) * AUDIO_SAMPLE_RATE_HZ / 1000.0 * 256.0 + 0.5))
+
+/*Sweep centers, and the widest sweep each mode's depth parameter scales*/
+#define CHORUS_CENTER MODULATION_DELAY_Q8(5.0)
+#define CHORUS_DEPTH MODULATION_DELAY_Q8(2.0)
+#define FLANGER_CENTER MODULATION_DELAY_Q8(1.6)
+#define FLANGER_DEPTH MODULATION_DELAY_Q8(1.35)
+#define VIBRATO_CENTER MODULATION_DELAY_Q8(2.0)
+#define VIBRATO_DEPTH MODULATION_DELAY_Q8(1.0)
+static const uint16_t modulationMaxSweep[MODULATION_MODES] PROGMEM = {CHORUS_DEPTH, FLANGER_DEPTH, VIBRATO_DEPTH, 0};
+
+static_assert(CHORUS_MODE + 1 == FLANGER_MODE && FLANGER_MODE + 1 == VIBRATO_MODE && VIBRATO_MODE + 1 == TREMOLO_MODE,
+              "ModulationParams arrays are indexed by mode - CHORUS_MODE");
+
+/*Rates in 0.01 Hz; tremolo gain swings between 1 - depth and 1*/
+const ParamInfo modulationParamTable[MODULATION_PARAM_COUNT] PROGMEM = {
+    PARAM_ENTRY("chor.rate", PARAM_U16, ModulationParams, rate[0], 5, 2000, 80),
+    PARAM_ENTRY("flng.rate", PARAM_U16, ModulationParams, rate[1], 5, 2000, 25),
+    PARAM_ENTRY("vib.rate", PARAM_U16, ModulationParams, rate[2], 5, 2000, 500),
+    PARAM_ENTRY("trem.rate", PARAM_U16, ModulationParams, rate[3], 5, 2000, 500),
+    PARAM_ENTRY("chor.depth", PARAM_Q15, ModulationParams, depth[0], 0, Q15_MAX, Q15_MAX),
+    PARAM_ENTRY("flng.depth", PARAM_Q15, ModulationParams, depth[1], 0, Q15_MAX, Q15_MAX),
+    PARAM_ENTRY("vib.depth", PARAM_Q15, ModulationParams, depth[2], 0, Q15_MAX, Q15_MAX),
+    PARAM_ENTRY("trem.depth", PARAM_Q15, ModulationParams, depth[3], 0, Q15_MAX, FLOAT_TO_Q15(0.7)),
+    PARAM_ENTRY("mod.mix", PARAM_Q15, ModulationParams, mix, 0, Q15_MAX, FLOAT_TO_Q15(0.5)),
+    PARAM_ENTRY("flng.fdbk", PARAM_Q15, ModulationParams, feedback, 0, FLOAT_TO_Q15(0.9), FLOAT_TO_Q15(0.6)),
+};
+
+/*Longest delay readInterpolated() can reach on the line, in 8.8 samples*/
+#define MODULATION_DELAY_LIMIT ((uint32_t)(((uint16_t)1 << MODULATION_DELAY_SIZE_LOG2) - 1) << 8)
+static_assert((uint32_t)CHORUS_CENTER + CHORUS_DEPTH < MODULATION_DELAY_LIMIT, "Chorus sweep exceeds the delay line");
+static_assert((uint32_t)FLANGER_CENTER + FLANGER_DEPTH < MODULATION_DELAY_LIMIT, "Flanger sweep exceeds the delay line");
+static_assert((uint32_t)VIBRATO_CENTER + VIBRATO_DEPTH < MODULATION_DELAY_LIMIT, "Vibrato sweep exceeds the delay line");
+static_assert(FLANGER_CENTER - FLANGER_DEPTH >= 256, "Flanger sweep must stay at least one sample deep");
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+void pinConfigModulation(void) {
+    // No specific pins for the modulation effects, common pins configured in main.cpp
+}
+
+void setupModulation(void) {
+    Serial.println(F("Modulation Pedal Ready!"));
+}
+
+void loopModulation(void) {
+    // No specific loop logic for the modulation effects, controls handled in main.cpp
+}
+
+/**
+ * @brief: Makes the next sample restart the line and LFO (see startModulation()).
+ */
+void restartModulation(void) {
+    effectState<ModulationEffect>().runningMode = CLEAN_MODE;
+}
+
+/**
+ * @brief: Converts rates to LFO steps and depths to sweeps. Runs in loop() when a setting changes.
+ */
+void deriveModulationParams(ModulationParams &params) {
+    for (uint8_t i = 0; i < MODULATION_MODES; i++) {
+        params.lfoStep[i] = (uint16_t)(((uint32_t)params.rate[i] * LFO_STEP_PER_CENTIHERTZ_Q16 + 0x8000) >> 16);
+        params.sweep[i] = (uint16_t)(((uint32_t)pgm_read_word(&modulationMaxSweep[i]) * (uint16_t)params.depth[i] + 0x4000) >> 15);
+    }
+}
+
+/**
+ * @brief: Restarts the shared delay line and LFO for mode. Runs in the ISR on the first
+ * sample of a new mode; the line clear is constant time (see delayline.h).
+ */
+static void startModulation(ModulationEffect::State &state, const ModulationParams &params, EffectMode mode) {
+    state.delay.clear();
+    uint16_t step = params.lfoStep[mode - CHORUS_MODE];
+    lfoStart(state.lfo, (mode == FLANGER_MODE) ? LFO_TRIANGLE : LFO_SINE, step);
+    state.runningMode = mode;
+}
+
+/**
+ * @brief: Reads the delay line at center +/- depth, swept by the LFO value.
+ * @param center, depth Delay in 8.8 fixed point samples.
+ */
+static inline q15_t readModulatedDelay(ModulationEffect::State &state, q15_t lfoValue, uint16_t center, uint16_t depth) {
+    uint16_t position = center + (int16_t)(((int32_t)lfoValue * depth) >> 15);
+    return state.delay.readInterpolated(position >> 8, (uint8_t)position);
+}
+
+/**
+ * @brief: Audio processing function for the modulation effects.
+ * @param inputSample The centered Q15 input audio sample.
+ * @param mode The effect to render (CHORUS_MODE, FLANGER_MODE, VIBRATO_MODE or TREMOLO_MODE).
+ * Passed in so the effects also work as stages of an effect chain.
+ * @return The processed Q15 sample, before master volume.
+ */
+q15_t processModulationAudio(q15_t inputSample, EffectMode mode) {
+    ModulationEffect::State &state = effectState<ModulationEffect>();
+    const ModulationParams &params = effectParams<ModulationEffect>().live();
+    q15_t outputSample;
+
+    if (state.runningMode != mode) {
+        startModulation(state, params, mode);
+    }
+    state.lfo.step = params.lfoStep[mode - CHORUS_MODE]; // Rate changes take effect at the next control point
+    q15_t lfoValue = lfoTick(state.lfo);
+
+    switch (mode) {
+        case CHORUS_MODE: {
+            q15_t wet = readModulatedDelay(state, lfoValue, CHORUS_CENTER, params.sweep[0]);
+            state.delay.write(inputSample);
+            outputSample = q15Mix(inputSample, wet, params.mix);
+            break;
+        }
+
+        case FLANGER_MODE: {
+            q15_t wet = readModulatedDelay(state, lfoValue, FLANGER_CENTER, params.sweep[1]);
+            state.delay.write(q15Add(inputSample, q15Mul(wet, params.feedback)));
+            outputSample = q15Mix(inputSample, wet, params.mix);
+            break;
+        }
+
+        case VIBRATO_MODE: {
+            outputSample = readModulatedDelay(state, lfoValue, VIBRATO_CENTER, params.sweep[2]);
+            state.delay.write(inputSample);
+            break;
+        }
+
+        case TREMOLO_MODE:
+        default: {
+            q15_t gain = Q15_MAX - q15Mul(params.depth[3], lfoUnipolar(lfoValue));
+            outputSample = q15Mul(inputSample, gain);
+            break;
+        }
+    }
+
+    return outputSample;
+}
@@ -1,7 +1,12 @@
 #include "octaver.h"
+#include "effects.h"
 #include <Arduino.h>
 
-
+const ParamInfo octaverParamTable[OCTAVER_PARAM_COUNT] PROGMEM = {
+    PARAM_ENTRY("oct.dry", PARAM_Q15, OctaverParams, dry, 0, Q15_MAX, FLOAT_TO_Q15(0.40)),
+    PARAM_ENTRY("oct.sub", PARAM_Q15, OctaverParams, sub, 0, Q15_MAX, FLOAT_TO_Q15(0.50)),
+    PARAM_ENTRY("oct.up", PARAM_Q15, OctaverParams, up, 0, Q15_MAX, FLOAT_TO_Q15(0.60)),
+};
 
 /*********************************************FUNCTION DEFINITIONS****************************************************/
 void pinConfigOctaver() {
@@ -9,7 +14,7 @@ void pinConfigOctaver() {
 }
 
 void setupOctaver(){
-    Serial.println("Octaver Pedal Ready!");
+    Serial.println(F("Octaver Pedal Ready!"));
 }
 
 void loopOctaver(){
@@ -18,45 +23,33 @@ void loopOctaver(){
 
 /**
  * @brief: Audio processing function for Octaver effect.
- * Currently a placeholder, but processes centered floating-point samples.
- * @param inputSample The raw 10-bit input audio sample (0-1023).
+ * Integer only: shifts, compares and three 16x16 multiplies for the mix, whatever the input.
+ * @param inputSample The centered Q15 input audio sample.
+ * @return The processed Q15 sample, before master volume.
  */
-void processOctaverAudio(int inputSample) {
-    float outputSampleFloat; // Use float for processing
-    float centered_input = (float)inputSample - 511.5; // Center input to -511.5 to 511.5
-
-    if (effectActive) {
-        // --- OCTAVER ALGORITHM PLACEHOLDER ---
-        // This is where your actual Octaver DSP would go.
-        // For a simple test, you could mix a very basic down-pitched signal.
-        // A true octaver requires complex algorithms (e.g., zero-crossing detection, wave shaping).
-        // For now, it behaves as a clean pass-through with volume.
-        
-        outputSampleFloat = centered_input; // Placeholder: currently just passes through centered signal
-        // Example: very crude half-wave rectifier for a simple 'fuzz' or sub-octave like sound
-        // if (centered_input < 0) centered_input = 0; // Half-wave rectification
-        // outputSampleFloat = centered_input;
-
-    } else {
-        outputSampleFloat = centered_input; // Pass through clean signal if effect is bypassed
+q15_t processOctaverAudio(q15_t inputSample) {
+    OctaverEffect::State &state = effectState<OctaverEffect>();
+    const OctaverParams &params = effectParams<OctaverEffect>().live();
+
+    // --- Octave down: hysteresis zero-crossing detector clocking a flip-flop ---
+    // The low-pass keeps harmonics from adding extra crossings. Both terms are shifted
+    // before subtracting so the difference cannot overflow a 16-bit int.
+    state.detector += (inputSample >> OCTAVER_DETECT_SHIFT) - (state.detector >> OCTAVER_DETECT_SHIFT);
+    if (state.positive) {
+        if (state.detector < -OCTAVER_HYSTERESIS) state.positive = false;
+    } else if (state.detector > OCTAVER_HYSTERESIS) {
+        state.positive = true;
+        state.subPolarity = !state.subPolarity; // One toggle per input period: half the frequency
     }
+    q15_t subOctave = state.subPolarity ? inputSample : q15Sub(0, inputSample);
 
-    // --- Final Output Processing ---
-    // Re-bias the processed sample to 0-1023 range
-    int finalOutputSample = (int)(outputSampleFloat + 511.5);
-
-    // Apply global master volume controlled by PUSHBUTTON_1/2
-    float volume_factor = pot2_value / 1023.0;
-    finalOutputSample = (int)(finalOutputSample * volume_factor);
-
-    // Constrain the final output to the valid 10-bit range (0-1023)
-    finalOutputSample = constrain(finalOutputSample, 0, 1023);
-
-    // // Split for dual PWM output
-    // analogWrite(AUDIO_OUT_A, finalOutputSample / 4);
-    // analogWrite(AUDIO_OUT_B, map(finalOutputSample % 4, 0, 3, 0, 255));
+    // --- Octave up: full-wave rectifier, then remove its DC offset ---
+    q15_t rectified = (inputSample < 0) ? q15Sub(0, inputSample) : inputSample;
+    state.dcLevel += rectified - (state.dcLevel >> OCTAVER_DC_SHIFT);
+    q15_t octaveUp = q15Sub(rectified, (q15_t)(state.dcLevel >> OCTAVER_DC_SHIFT));
 
-    /*write the PWM output signal*/
-    OCR1AL = ((finalOutputSample + 0x8000) >> 8); // convert to unsigned, send out high byte
-    OCR1BL = finalOutputSample; // send out low byte
+    // --- Dry/sub/up mix, accumulated at full precision and saturated once ---
+    int32_t mix = (int32_t)inputSample * params.dry + (int32_t)subOctave * params.sub +
+                  (int32_t)octaveUp * params.up;
+    return q15Saturate(mix >> 15);
 }
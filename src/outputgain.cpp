@@ -0,0 +1,30 @@
+#include "outputgain.h"
+#include <Arduino.h>
+
+volatile q15_t outputGainTarget = 0;
+q15_t outputGainCurrent = 0;
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Sets the output gain for a volume setting (0-1024), interpolating between the
+ * taper table points. Called from loop() when the volume changes, never per sample.
+ * @param immediate Jump to the new gain instead of ramping, e.g. in setup().
+ */
+void outputGainSetVolume(int volume, bool immediate) {
+    volume = constrain(volume, 0, 1024);
+    uint8_t point = volume >> OUTPUT_GAIN_VOLUME_SHIFT;
+    q15_t gain = (q15_t)pgm_read_word(&outputGainTable[point]);
+    if (point < OUTPUT_GAIN_TABLE_POINTS - 1) {
+        q15_t next = (q15_t)pgm_read_word(&outputGainTable[point + 1]);
+        uint8_t fraction = volume & ((1 << OUTPUT_GAIN_VOLUME_SHIFT) - 1);
+        gain += (q15_t)(((int32_t)(next - gain) * fraction) >> OUTPUT_GAIN_VOLUME_SHIFT);
+    }
+
+    uint8_t oldSREG = SREG; // The ISR must not see half of the 16-bit gain
+    cli();
+    outputGainTarget = gain;
+    if (immediate) {
+        outputGainCurrent = gain;
+    }
+    SREG = oldSREG;
+}
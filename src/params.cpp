@@ -0,0 +1,48 @@
+#include "effects.h"
+#include <Arduino.h>
+
+ActiveEffects::ParamLayout effectParamBanks; // Filled with the table defaults by paramsSetupAll()
+
+static_assert(sizeof(ActiveEffects::ParamLayout) <= PARAM_BANK_BYTES,
+              "Parameter banks exceed PARAM_BANK_BYTES; trim a Params struct or drop an effect from ActiveEffects");
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Copies one parameter table entry out of flash.
+ */
+void paramInfoRead(const ParamInfo *table, uint8_t param, ParamInfo &info) {
+    memcpy_P(&info, &table[param], sizeof(ParamInfo));
+}
+
+/**
+ * @brief: True if value lies within the entry's range, compared as signed for Q types.
+ */
+bool paramInRange(const ParamInfo &info, uint16_t value) {
+    if (info.type == PARAM_Q15 || info.type == PARAM_Q7_8) {
+        return (int16_t)value >= (int16_t)info.min && (int16_t)value <= (int16_t)info.max;
+    }
+    return value >= info.min && value <= info.max;
+}
+
+/**
+ * @brief: Reads a parameter from a Params block as a raw 16-bit value.
+ */
+uint16_t paramRead(const void *params, const ParamInfo &info) {
+    const uint8_t *field = (const uint8_t *)params + info.offset;
+    if (info.type == PARAM_U8) {
+        return *field;
+    }
+    return *(const uint16_t *)field;
+}
+
+/**
+ * @brief: Stores a raw 16-bit value into a Params block. No range check.
+ */
+void paramWrite(void *params, const ParamInfo &info, uint16_t value) {
+    uint8_t *field = (uint8_t *)params + info.offset;
+    if (info.type == PARAM_U8) {
+        *field = (uint8_t)value;
+    } else {
+        *(uint16_t *)field = value;
+    }
+}
@@ -0,0 +1,309 @@
+#include "preset.h"
+#include "effects.h"
+#include <Arduino.h>
+#include <avr/eeprom.h>
+
+/*Record layout*/
+#define PRESET_SLOT_OFFSET 0     // 0 for the last-used ring, 1..PRESET_USER_SLOTS for user presets
+#define PRESET_SEQUENCE_OFFSET 1 // uint16 LE, ring records only
+#define PRESET_MODE_OFFSET 3
+#define PRESET_VOLUME_OFFSET 4   // uint16 LE, 0-1024
+#define PRESET_LAYOUT_OFFSET 6   // uint16 LE, layout signature
+#define PRESET_HEADER_BYTES 8
+#define PRESET_LAST_USED 0
+
+static constexpr uint8_t PRESET_PAYLOAD_END = PRESET_HEADER_BYTES + 2 * ActiveEffects::totalParamCount;
+static constexpr uint8_t PRESET_RECORD_BYTES = PRESET_PAYLOAD_END + 2; // CRC-16 last
+static constexpr uint16_t PRESET_RING_START = PRESET_USER_SLOTS * PRESET_RECORD_BYTES;
+static constexpr uint8_t PRESET_RING_SLOTS = (E2END + 1 - PRESET_RING_START) / PRESET_RECORD_BYTES;
+
+static_assert(PRESET_HEADER_BYTES + 2 * ActiveEffects::totalParamCount + 2 <= 255, "Preset record exceeds 255 bytes");
+static_assert(PRESET_RING_SLOTS >= 2, "EEPROM too small for the preset ring; lower PRESET_USER_SLOTS");
+
+/*Record being written, one byte per presetService() call*/
+struct PresetWriter {
+    uint16_t address;    // EEPROM address of the record
+    uint16_t sequence;
+    uint16_t crc;        // CRC of the bytes written so far
+    uint16_t payloadCrc; // CRC of the mode, volume and parameter bytes, for change detection
+    uint16_t value;      // 16-bit field being written, fetched with its low byte
+    uint8_t slot;
+    uint8_t position;    // Next byte, PRESET_RECORD_BYTES when idle
+};
+
+static PresetWriter writer = {0, 0, 0, 0, 0, 0, PRESET_RECORD_BYTES};
+static uint16_t layoutSignature;
+static uint16_t ringSequence;     // Sequence of the newest ring record
+static uint8_t ringNext;          // Ring slot the next save goes to
+static uint16_t savedPayloadCrc;  // Live state as of the newest ring record
+static uint16_t checkedPayloadCrc; // Live state at the last check
+static unsigned long lastCheckMs;
+static unsigned long lastChangeMs;
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: CRC-16/CCITT (0x1021), one byte at a time.
+ */
+static uint16_t presetCrcUpdate(uint16_t crc, uint8_t data) {
+    crc ^= (uint16_t)data << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+/**
+ * @brief: Live value of a parameter by its position across all parameter tables.
+ */
+static uint16_t presetParamGet(uint8_t index) {
+    for (uint8_t effect = 0; effect < ActiveEffects::effectCount; effect++) {
+        const ParamInfo *table;
+        uint8_t count = ActiveEffects::params(effect, table);
+        if (index < count) {
+            uint16_t value = 0;
+            ActiveEffects::paramGet(effectParamBanks, effect, index, value);
+            return value;
+        }
+        index -= count;
+    }
+    return 0;
+}
+
+/**
+ * @brief: Publishes a parameter by its position across all parameter tables. Values out of
+ * range are ignored, so a damaged record cannot push an effect past its limits.
+ */
+static void presetParamSet(uint8_t index, uint16_t value) {
+    for (uint8_t effect = 0; effect < ActiveEffects::effectCount; effect++) {
+        const ParamInfo *table;
+        uint8_t count = ActiveEffects::params(effect, table);
+        if (index < count) {
+            ActiveEffects::paramSet(effectParamBanks, effect, index, value);
+            return;
+        }
+        index -= count;
+    }
+}
+
+/**
+ * @brief: CRC of every parameter table entry, so records only load into the firmware
+ * that wrote them (or one with identical tables).
+ */
+static uint16_t presetLayoutSignature(void) {
+    uint16_t crc = 0xFFFF;
+    for (uint8_t effect = 0; effect < ActiveEffects::effectCount; effect++) {
+        const ParamInfo *table;
+        uint8_t count = ActiveEffects::params(effect, table);
+        crc = presetCrcUpdate(crc, count);
+        for (uint8_t param = 0; param < count; param++) {
+            ParamInfo info;
+            paramInfoRead(table, param, info);
+            const uint8_t *bytes = (const uint8_t *)&info;
+            for (uint8_t i = 0; i < sizeof(ParamInfo); i++) {
+                crc = presetCrcUpdate(crc, bytes[i]);
+            }
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief: Byte of the live state at a payload position of a record.
+ * @param value Holds a 16-bit field between the calls for its low and high byte, so
+ * both bytes come from the same value.
+ */
+static uint8_t presetLiveByte(uint8_t position, uint16_t &value) {
+    switch (position) {
+        case PRESET_MODE_OFFSET:       return (uint8_t)lastSelectedMode;
+        case PRESET_VOLUME_OFFSET:     value = (uint16_t)pot2_value; return (uint8_t)value;
+        case PRESET_LAYOUT_OFFSET:     value = layoutSignature; return (uint8_t)value;
+        case PRESET_VOLUME_OFFSET + 1:
+        case PRESET_LAYOUT_OFFSET + 1: return (uint8_t)(value >> 8);
+        default: break;
+    }
+    uint8_t offset = position - PRESET_HEADER_BYTES;
+    if (offset & 1) {
+        return (uint8_t)(value >> 8);
+    }
+    value = presetParamGet(offset >> 1);
+    return (uint8_t)value;
+}
+
+/**
+ * @brief: CRC of the payload the live state would be saved as.
+ */
+static uint16_t presetLivePayloadCrc(void) {
+    uint16_t crc = 0xFFFF;
+    uint16_t value = 0;
+    for (uint8_t position = PRESET_MODE_OFFSET; position < PRESET_PAYLOAD_END; position++) {
+        crc = presetCrcUpdate(crc, presetLiveByte(position, value));
+    }
+    return crc;
+}
+
+static inline uint8_t presetRead(uint16_t address) {
+    return eeprom_read_byte((const uint8_t *)(uintptr_t)address);
+}
+
+static inline uint16_t presetRead16(uint16_t address) {
+    return presetRead(address) | ((uint16_t)presetRead(address + 1) << 8);
+}
+
+/**
+ * @brief: True if the record at address belongs to slot, passes its CRC and was written
+ * with the current parameter tables.
+ */
+static bool presetRecordValid(uint16_t address, uint8_t slot) {
+    uint16_t crc = 0xFFFF;
+    for (uint8_t position = 0; position < PRESET_PAYLOAD_END; position++) {
+        crc = presetCrcUpdate(crc, presetRead(address + position));
+    }
+    return crc == presetRead16(address + PRESET_PAYLOAD_END) && presetRead(address + PRESET_SLOT_OFFSET) == slot &&
+           presetRead16(address + PRESET_LAYOUT_OFFSET) == layoutSignature;
+}
+
+/**
+ * @brief: Loads a validated record into the running pedal: mode, volume and parameters.
+ */
+static void presetApply(uint16_t address) {
+    setMasterVolume(presetRead16(address + PRESET_VOLUME_OFFSET));
+    for (uint8_t index = 0; index < ActiveEffects::totalParamCount; index++) {
+        presetParamSet(index, presetRead16(address + PRESET_HEADER_BYTES + 2 * index));
+    }
+    uint8_t mode = presetRead(address + PRESET_MODE_OFFSET);
+    if (mode < NUM_EFFECTS_ENUM) {
+        selectEffectMode((EffectMode)mode); // Ignored if the effect is no longer compiled in
+    }
+}
+
+/**
+ * @brief: Starts writing the live state as a record. presetService() does the writing.
+ */
+static void presetStartWrite(uint16_t address, uint8_t slot, uint16_t sequence) {
+    writer.address = address;
+    writer.slot = slot;
+    writer.sequence = sequence;
+    writer.crc = 0xFFFF;
+    writer.payloadCrc = 0xFFFF;
+    writer.position = 0;
+}
+
+/**
+ * @brief: Writes the next byte of the record in progress, if the EEPROM is ready.
+ * The CRC goes last: until it is written the record reads as invalid.
+ */
+static void presetWriteNext(void) {
+    if (!eeprom_is_ready()) {
+        return;
+    }
+    uint8_t position = writer.position;
+    uint8_t data;
+    if (position == PRESET_SLOT_OFFSET) {
+        data = writer.slot;
+    } else if (position == PRESET_SEQUENCE_OFFSET) {
+        data = (uint8_t)writer.sequence;
+    } else if (position == PRESET_SEQUENCE_OFFSET + 1) {
+        data = (uint8_t)(writer.sequence >> 8);
+    } else if (position < PRESET_PAYLOAD_END) {
+        data = presetLiveByte(position, writer.value);
+        writer.payloadCrc = presetCrcUpdate(writer.payloadCrc, data);
+    } else {
+        data = (position == PRESET_PAYLOAD_END) ? (uint8_t)writer.crc : (uint8_t)(writer.crc >> 8);
+    }
+    if (position < PRESET_PAYLOAD_END) {
+        writer.crc = presetCrcUpdate(writer.crc, data);
+    }
+    eeprom_update_byte((uint8_t *)(uintptr_t)(writer.address + position), data);
+
+    if (++writer.position == PRESET_RECORD_BYTES && writer.slot == PRESET_LAST_USED) {
+        ringSequence = writer.sequence;
+        ringNext = (ringNext + 1 < PRESET_RING_SLOTS) ? ringNext + 1 : 0;
+        savedPayloadCrc = writer.payloadCrc;
+    }
+}
+
+/**
+ * @brief: Restores the last-used state from the newest valid ring record.
+ * Called once in setup(), after the parameter defaults are loaded and transitionSetup().
+ * @return false if the ring holds no valid record (new part, or other firmware); the
+ * defaults then stay and the first save starts the ring.
+ */
+bool presetSetup(void) {
+    layoutSignature = presetLayoutSignature();
+
+    int8_t newest = -1;
+    ringSequence = 0;
+    ringNext = 0;
+    for (uint8_t slot = 0; slot < PRESET_RING_SLOTS; slot++) {
+        uint16_t address = PRESET_RING_START + slot * PRESET_RECORD_BYTES;
+        if (!presetRecordValid(address, PRESET_LAST_USED)) {
+            continue;
+        }
+        uint16_t sequence = presetRead16(address + PRESET_SEQUENCE_OFFSET);
+        if (newest < 0 || (int16_t)(sequence - ringSequence) > 0) { // Wraparound-safe comparison
+            newest = slot;
+            ringSequence = sequence;
+        }
+    }
+
+    if (newest >= 0) {
+        presetApply(PRESET_RING_START + newest * PRESET_RECORD_BYTES);
+        ringNext = (newest + 1 < PRESET_RING_SLOTS) ? newest + 1 : 0;
+    }
+    savedPayloadCrc = presetLivePayloadCrc();
+    checkedPayloadCrc = savedPayloadCrc;
+    Serial.print(F("Presets: ")); Serial.print(PRESET_RING_SLOTS); Serial.print(F(" ring slots of "));
+    Serial.print(PRESET_RECORD_BYTES); Serial.println(newest >= 0 ? F(" bytes, restored") : F(" bytes, defaults"));
+    return newest >= 0;
+}
+
+/**
+ * @brief: Saves the last-used state once changes have settled, and advances any write in
+ * progress by one byte. Called from loop().
+ */
+void presetService(void) {
+    if (writer.position < PRESET_RECORD_BYTES) {
+        presetWriteNext();
+        return;
+    }
+
+    unsigned long now = millis();
+    if (now - lastCheckMs < PRESET_CHECK_MS) {
+        return;
+    }
+    lastCheckMs = now;
+
+    uint16_t crc = presetLivePayloadCrc();
+    if (crc != checkedPayloadCrc) {
+        checkedPayloadCrc = crc; // Still changing: wait for it to settle
+        lastChangeMs = now;
+    } else if (crc != savedPayloadCrc && now - lastChangeMs >= PRESET_SETTLE_MS) {
+        presetStartWrite(PRESET_RING_START + ringNext * PRESET_RECORD_BYTES, PRESET_LAST_USED, ringSequence + 1);
+    }
+}
+
+/**
+ * @brief: Stores the live state as user preset 1..PRESET_USER_SLOTS. The write completes
+ * over the next loop() passes.
+ * @return A ParamStatus: PARAM_BUSY while another record is being written.
+ */
+uint8_t presetSave(uint8_t preset) {
+    if (preset < 1 || preset > PRESET_USER_SLOTS) return PARAM_UNKNOWN;
+    if (writer.position < PRESET_RECORD_BYTES) return PARAM_BUSY;
+    presetStartWrite((preset - 1) * PRESET_RECORD_BYTES, preset, 0);
+    return PARAM_OK;
+}
+
+/**
+ * @brief: Loads user preset 1..PRESET_USER_SLOTS. The last-used ring picks it up like any
+ * other change.
+ * @return A ParamStatus: PARAM_UNKNOWN if the preset is empty, damaged or from other firmware.
+ */
+uint8_t presetLoad(uint8_t preset) {
+    if (preset < 1 || preset > PRESET_USER_SLOTS) return PARAM_UNKNOWN;
+    uint16_t address = (preset - 1) * PRESET_RECORD_BYTES;
+    if (writer.position < PRESET_RECORD_BYTES && writer.address == address) return PARAM_BUSY;
+    if (!presetRecordValid(address, preset)) return PARAM_UNKNOWN;
+    presetApply(address);
+    return PARAM_OK;
+}
@@ -1,120 +1,218 @@
 #include "reverb.h"
+#include "effects.h"
+#include "effectchain.h"
 #include <Arduino.h>
 
+static_assert(REVERB_COMBS >= 1 && REVERB_COMBS <= 4, "REVERB_COMBS must be 1 to 4");
+static_assert(REVERB_ALLPASSES >= 1 && REVERB_ALLPASSES <= 2, "REVERB_ALLPASSES must be 1 to 2");
+static_assert(REVERB_COMBS + REVERB_ALLPASSES < REVERB_DECIMATION,
+              "The reverb filters need a sample slot each, plus one for the block end; raise REVERB_DECIMATION_LOG2");
+static_assert(REVERB_COMB_CYCLES >= REVERB_ALLPASS_CYCLES && REVERB_COMB_CYCLES >= REVERB_BLOCK_CYCLES,
+              "ReverbEffect::worstCaseCycles assumes a comb slot is the heaviest");
+static_assert(ISR_FIXED_CYCLES + ReverbEffect::worstCaseCycles <= AUDIO_SAMPLE_PERIOD_CYCLES,
+              "Reverb network does not fit one sample period");
+
+/*Filter lengths in network samples, all prime (so mutually prime) and spread like
+ * Freeverb's tunings: combs within ~1.3x of each other, all-passes shorter.*/
+static const uint8_t reverbCombLengths[4] PROGMEM = {61, 59, 53, 47};
+static const uint8_t reverbAllpassLengths[2] PROGMEM = {13, 11};
+
+/*Fixed network coefficients; room size, damping and mix are parameters*/
+static const q15_t reverbInputGain = FLOAT_TO_Q15(0.5);                 // Headroom for the comb resonances
+static const q15_t reverbAllpassGain = FLOAT_TO_Q15(0.5);
+static const q7_8_t reverbWetGain = FLOAT_TO_Q7_8(2.0 / REVERB_COMBS); // Undo the input headroom
+
+/*Room size stops at 0.93: above 1 - 0.5 / REVERB_DEADBAND_LSB the rounding in
+ * reverbLineSample() could no longer stop the tail from ringing on*/
+const ParamInfo reverbParamTable[REVERB_PARAM_COUNT] PROGMEM = {
+    PARAM_ENTRY("rev.room", PARAM_Q15, ReverbParams, roomSize, FLOAT_TO_Q15(0.5), FLOAT_TO_Q15(0.93), FLOAT_TO_Q15(0.93)),
+    PARAM_ENTRY("rev.damp", PARAM_Q15, ReverbParams, damping, 0, FLOAT_TO_Q15(0.9), FLOAT_TO_Q15(0.25)),
+    PARAM_ENTRY("rev.mix", PARAM_Q15, ReverbParams, mix, 0, Q15_MAX, FLOAT_TO_Q15(0.50)),
+    PARAM_ENTRY("delay.time", PARAM_U16, ReverbParams, time, DELAY_SAMPLES_TO_US(1), REVERB_DELAY_MAX_US, 3984), // us; 125 samples at 31.4 kHz
+    PARAM_ENTRY("delay.fdbk", PARAM_Q15, ReverbParams, feedback, 0, FLOAT_TO_Q15(0.95), FLOAT_TO_Q15(0.75)),
+};
+
+/*Line steps below which a decaying tail is rounded toward zero (see reverbLineSample):
+ * 0.5 / (1 - gain) for the feedback gain of the line, rounded up*/
+#define REVERB_DEADBAND_LSB 8         // Combs, room size up to 0.93
+#define REVERB_ALLPASS_DEADBAND_LSB 1 // All-passes, reverbAllpassGain 0.5
+
 /*********************************************FUNCTION DEFINITIONS****************************************************/
 void pinConfigReverb(){
     // No specific pins for Reverb, common pins configured in main.cpp
 }
 
 void setUpReverb(){
-    Serial.println("Reverb Pedal Ready!");
+    Serial.println(F("Reverb Pedal Ready!"));
 }
 
 void loopReverb(){
-    // This loop logic specifically handles the TOGGLE switch for Reverb sub-modes.
-    // It only applies if the current global mode is one of the REVERB sub-modes.
-    if (currentActiveMode == REVERB_ECHO_MODE || currentActiveMode == DELAY_MODE) {
-        bool toggleState = digitalRead(TOGGLE);
-        EffectMode targetMode = (toggleState == HIGH) ? REVERB_ECHO_MODE : DELAY_MODE;
-
-        if (currentActiveMode != targetMode) {
-            if (millis() - lastToggleSwitchStateChange > DEBOUNCE_DELAY_MS) {
-                lastToggleSwitchStateChange = millis();
-                currentActiveMode = targetMode; // Update the global current effect mode.
-                Serial.print("Reverb Sub-Mode: ");
-                Serial.println((currentActiveMode == REVERB_ECHO_MODE) ? "REVERB (Echo)" : "DELAY (Repeats)");
-                for (int i = 0; i < MAX_DELAY; i++) {
-                    delayBuffer[i] = 0;
-                }
-                delayWritePointer = 0;
-            }
+    // The TOGGLE switch that picks REVERB_ECHO_MODE or DELAY_MODE is handled with the
+    // other inputs by the mode state machine in main.cpp (see inputs.h).
+}
+
+/**
+ * @brief: Makes the next sample clear the lines for its sub-mode (see reverbSelectLines()).
+ */
+void restartReverb(){
+    effectState<ReverbEffect>().linesMode = CLEAN_MODE;
+}
+
+/**
+ * @brief: Converts the DELAY_MODE time to a line offset. Runs in loop() when a setting changes.
+ */
+void deriveReverbParams(ReverbParams &params) {
+    params.delaySamples = DELAY_US_TO_SAMPLES(params.time);
+}
+
+/**
+ * @brief: Rounds a sample to the BITS a reverb line keeps, as it recirculates; returns the
+ * value the line will store.
+ * Above DEADBAND line steps it rounds to nearest, below it rounds toward zero.
+ * Round-to-nearest alone would leave the tail ringing forever at the level where
+ * feedback * x rounds back to x (0.5 / (1 - 0.93) ~ 7 steps for a comb), and truncation
+ * alone (what the line does) sticks at -1 step.
+ */
+template <uint8_t BITS, uint8_t DEADBAND> static inline q15_t reverbLineSample(q15_t sample) {
+    const q15_t step = (q15_t)1 << (16 - BITS);
+    const q15_t deadband = DEADBAND * step;
+    if (sample >= deadband || sample <= -deadband) {
+        sample = (sample < Q15_MAX - step / 2) ? (q15_t)(sample + step / 2) : sample;
+    } else if (sample < 0) {
+        sample = (q15_t)(sample + step - 1);
+    }
+    return (q15_t)(sample & -step);
+}
+
+/**
+ * @brief: Writes one comb's feedback sample with error feedback: the rounding error of
+ * each write is added to the next one, so the line loses no level to rounding on
+ * average. Rounding alone, toward zero in the deadband, lost up to a step per pass and
+ * halved the tail. Decay against the float network: see test_reverb_decay (test_kernels).
+ */
+static inline void reverbCombWrite(ReverbComb &comb, int8_t &residual, q15_t sample) {
+    q15_t wanted = q15Saturate((int32_t)sample + residual);
+    q15_t stored = reverbLineSample<REVERB_COMB_BITS, REVERB_DEADBAND_LSB>(wanted);
+    residual = (int8_t)(wanted - stored); // Under one line step
+    comb.line.write(stored);
+}
+
+/**
+ * @brief: Clears the lines of the sub-mode about to run. Constant time (see delayline.h).
+ */
+static void reverbSelectLines(ReverbEffect::State &state, EffectMode mode) {
+    if (mode == REVERB_ECHO_MODE) {
+        ReverbNetwork &network = state.lines.network;
+        for (uint8_t i = 0; i < REVERB_COMBS; i++) {
+            network.comb[i].line.clear();
+            network.comb[i].damped = 0;
+            network.combResidual[i] = 0;
+        }
+        for (uint8_t i = 0; i < REVERB_ALLPASSES; i++) {
+            network.allpass[i].clear();
         }
+        network.combSum = 0;
+        network.inputSum = 0;
+        network.blockInput = 0;
+        network.wet = 0;
+        network.ramp = 0;
+        network.rampStep = 0;
+        network.slot = 0;
+    } else {
+        state.lines.delay.clear();
     }
+    state.linesMode = mode;
 }
 
 /**
- * @brief: Audio processing function for Reverb/Delay effect.
- * Uses centered floating-point math to prevent clipping and buzzing.
- * @param inputSample The raw 10-bit input audio sample (0-1023).
+ * @brief: One sample of the decimated comb/all-pass network: adds the input to the block
+ * average, runs the filter whose slot this is and returns the ramped wet output.
+ * The combs take the previous block's input, so the wet output trails the dry by two
+ * to three blocks (under 1 ms) on top of the comb delays.
+ * @param inputSample The centered Q15 input audio sample.
+ * @return The wet reverb signal.
  */
-void processReverbAudio(int inputSample) {
-    float outputSampleFloat; // Use float for processing to avoid clipping
-    float centered_input = (float)inputSample - 511.5; // Center input to -511.5 to 511.5
-
-    if (effectActive) {
-        // --- Fixed Effect Parameters ---
-        const int fixedDelayTimeValue = 500; // Maps to approx MAX_DELAY/2
-        const float fixedFeedbackValue = 0.75; // 75% feedback (0.0 to 0.95 range)
-        const float fixedWetDryMix = 0.70; // 70% wet for reverb-like mode
-
-        delayReadOffset = map(fixedDelayTimeValue, 0, 1023, 1, MAX_DELAY - 1);
-        int delayReadPointer = (delayWritePointer + (MAX_DELAY - delayReadOffset)) % MAX_DELAY;
-
-        // Get delayed sample from buffer and center it
-        float delayedSample_Centered = (float)delayBuffer[delayReadPointer] - 511.5;
-
-        float mixedSampleForBuffer_Centered;
-        float currentDelayedSample_Centered;
-
-        switch (currentActiveMode) {
-            case REVERB_ECHO_MODE: {
-                // Mix current input with delayed sample for the buffer itself (feedback loop for smearing)
-                mixedSampleForBuffer_Centered = centered_input * (1.0 - fixedFeedbackValue) + delayedSample_Centered * fixedFeedbackValue;
-                
-                // For final output, blend dry input and wet delayed signal
-                outputSampleFloat = centered_input * (1.0 - fixedWetDryMix) + delayedSample_Centered * fixedWetDryMix;
-                break;
-            }
-
-            case DELAY_MODE: {
-                // Calculate new sample to store in buffer: current input + portion of delayed signal (for repeats)
-                mixedSampleForBuffer_Centered = centered_input + (delayedSample_Centered * fixedFeedbackValue);
-                
-                // Final output sample is sum of dry input and delayed signal
-                outputSampleFloat = centered_input + delayedSample_Centered;
-                break;
-            }
-
-            case CLEAN_MODE:
-            default: {
-                outputSampleFloat = centered_input; // Pure bypass (centered)
-                for (int i = 0; i < MAX_DELAY; i++) { delayBuffer[i] = 0; } // Clear buffer
-                delayWritePointer = 0; // Reset write pointer
-                break;
-            }
+static inline q15_t processReverbNetwork(ReverbNetwork &network, const ReverbParams &params, q15_t inputSample) {
+    uint8_t slot = network.slot;
+    network.inputSum += inputSample >> REVERB_DECIMATION_LOG2;
+
+    if (slot < REVERB_COMBS) {
+        // Parallel combs, one per slot: line <- input + damped(line output) * feedback
+        ReverbComb &comb = network.comb[slot];
+        q15_t combOutput = comb.line.read(pgm_read_byte(&reverbCombLengths[slot]));
+        comb.damped = q15Mix(combOutput, comb.damped, params.damping);
+        reverbCombWrite(comb, network.combResidual[slot], q15Add(network.blockInput, q15Mul(comb.damped, params.roomSize)));
+        network.combSum += combOutput;
+    } else if (slot < REVERB_COMBS + REVERB_ALLPASSES) {
+        // Series all-passes (Freeverb form): output = line output - input, line <- input + line output * gain
+        uint8_t i = slot - REVERB_COMBS;
+        if (i == 0) {
+            network.wet = q15Saturate(network.combSum);
+            network.combSum = 0;
         }
-        
-        // Store mixedSampleForBuffer_Centered back into buffer after re-biasing
-        delayBuffer[delayWritePointer] = (uint16_t)constrain(mixedSampleForBuffer_Centered + 511.5, 0, 1023);
-
-    } else { // If effect is not active, pass through clean signal
-        outputSampleFloat = centered_input;
-        for (int i = 0; i < MAX_DELAY; i++) { delayBuffer[i] = 0; } // Always clear buffer on bypass
-        delayWritePointer = 0;
+        q15_t lineOutput = network.allpass[i].read(pgm_read_byte(&reverbAllpassLengths[i]));
+        network.allpass[i].write(reverbLineSample<REVERB_ALLPASS_BITS, REVERB_ALLPASS_DEADBAND_LSB>(q15Add(network.wet, q15Mul(lineOutput, reverbAllpassGain))));
+        network.wet = q15Sub(lineOutput, network.wet);
     }
 
-    // Update Delay Buffer Write Pointer
-    delayWritePointer++;
-    if (delayWritePointer >= MAX_DELAY) {
-        delayWritePointer = 0;
+    q15_t output = network.ramp;
+    network.ramp = q15Add(output, network.rampStep);
+    if (++slot == REVERB_DECIMATION) {
+        // Block end: the combs get this block's input, the ramp heads for its output
+        slot = 0;
+        network.blockInput = q15Mul(network.inputSum, reverbInputGain);
+        network.inputSum = 0;
+        network.rampStep = (q15_t)(((int32_t)q15Gain(network.wet, reverbWetGain) - network.ramp) >> REVERB_DECIMATION_LOG2);
     }
+    network.slot = slot;
+    return output;
+}
 
-    // --- Final Output Processing ---
-    // Re-bias the processed sample to 0-1023 range
-    int finalOutputSample = (int)(outputSampleFloat + 511.5);
+/**
+ * @brief: Audio processing function for Reverb/Delay effect.
+ * Uses centered Q15 fixed-point math to prevent clipping and buzzing.
+ * REVERB_ECHO_MODE runs the comb/all-pass network, DELAY_MODE a single feedback tap.
+ * @param inputSample The centered Q15 input audio sample.
+ * @param mode The sub-mode to render (REVERB_ECHO_MODE or DELAY_MODE). Passed in rather than
+ * read from currentActiveMode so the effect also works as a stage of an effect chain.
+ * @return The processed Q15 sample, before master volume.
+ */
+q15_t processReverbAudio(q15_t inputSample, EffectMode mode) {
+    ReverbEffect::State &state = effectState<ReverbEffect>();
+    const ReverbParams &params = effectParams<ReverbEffect>().live();
+    q15_t outputSample;
+
+    // Both sub-modes share the same lines: start from silence when switching
+    if (state.linesMode != mode) {
+        reverbSelectLines(state, mode);
+    }
+
+    switch (mode) {
+        case REVERB_ECHO_MODE: {
+            // Blend dry input and the diffused reverb tail
+            outputSample = q15Mix(inputSample, processReverbNetwork(state.lines.network, params, inputSample), params.mix);
+            break;
+        }
 
-    // Apply global master volume controlled by PUSHBUTTON_1/2
-    float volume_factor = pot2_value / 1023.0;
-    finalOutputSample = (int)(finalOutputSample * volume_factor);
+        case DELAY_MODE: {
+            // Get delayed sample from the delay line
+            q15_t delayedSample = state.lines.delay.read(params.delaySamples);
 
-    // Constrain the final output to the valid 10-bit range (0-1023)
-    finalOutputSample = constrain(finalOutputSample, 0, 1023);
+            // Store current input + portion of delayed signal (for repeats) and advance the line
+            state.lines.delay.write(q15Add(inputSample, q15Mul(delayedSample, params.feedback)));
 
-    // // Split for dual PWM output
-    // analogWrite(AUDIO_OUT_A, finalOutputSample / 4);
-    // analogWrite(AUDIO_OUT_B, map(finalOutputSample % 4, 0, 3, 0, 255));
+            // Final output sample is sum of dry input and delayed signal
+            outputSample = q15Add(inputSample, delayedSample);
+            break;
+        }
+
+        case CLEAN_MODE:
+        default: {
+            outputSample = inputSample; // Pure bypass
+            state.linesMode = CLEAN_MODE;
+            break;
+        }
+    }
 
-    /*write the PWM output signal*/
-    OCR1AL = ((finalOutputSample + 0x8000) >> 8); // convert to unsigned, send out high byte
-    OCR1BL = finalOutputSample; // send out low byte
+    return outputSample;
 }
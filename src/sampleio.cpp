@@ -0,0 +1,9 @@
+#include "sampleio.h"
+
+#if SAMPLE_IO_BACKEND == SAMPLE_IO_BUFFER
+SampleIoBuffer sampleIoBuffer; // Bound by the host renderer or a test before the ISR runs
+#elif SAMPLE_IO_BACKEND == SAMPLE_IO_STREAM
+FILE *sampleIoStreamIn;
+FILE *sampleIoStreamOut;
+bool sampleIoStreamEnded;
+#endif
@@ -0,0 +1,157 @@
+#include "serialcommands.h"
+#include "effects.h"
+#include "isrprofile.h"
+#include "telemetry.h"
+#include "preset.h"
+#include <Arduino.h>
+
+#define PARAM_REPLY_MAX_PAYLOAD 24
+static_assert(1 + ActiveEffects::effectCount <= PARAM_REPLY_MAX_PAYLOAD && 7 + PARAM_NAME_CHARS <= PARAM_REPLY_MAX_PAYLOAD,
+              "Parameter protocol reply does not fit PARAM_REPLY_MAX_PAYLOAD");
+
+static uint8_t request[PARAM_REQUEST_BYTES]; // Parameter request being received
+static uint8_t requestLength = 0;            // Bytes of it received so far, 0 when idle
+static unsigned long requestStartMs;
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Sends one parameter protocol reply. payload is not read when length is 0 and may be nullptr.
+ */
+static void sendParamReply(uint8_t command, uint8_t status, uint8_t effect, uint8_t param,
+                           const uint8_t *payload, uint8_t length) {
+    uint8_t checksum = command + status + effect + param + length;
+    Serial.write(PARAM_SYNC);
+    Serial.write(command);
+    Serial.write(status);
+    Serial.write(effect);
+    Serial.write(param);
+    Serial.write(length);
+    for (uint8_t i = 0; i < length; i++) {
+        Serial.write(payload[i]);
+        checksum += payload[i];
+    }
+    Serial.write(checksum);
+}
+
+/**
+ * @brief: Executes a complete parameter request and replies to it.
+ */
+static void handleParamRequest(void) {
+    uint8_t command = request[1];
+    uint8_t effect = request[2];
+    uint8_t param = request[3];
+    uint16_t value = request[4] | ((uint16_t)request[5] << 8);
+    uint8_t payload[PARAM_REPLY_MAX_PAYLOAD];
+    uint8_t length = 0;
+    uint8_t status = PARAM_OK;
+
+    uint8_t checksum = 0;
+    for (uint8_t i = 1; i < PARAM_REQUEST_BYTES - 1; i++) {
+        checksum += request[i];
+    }
+    if (checksum != request[PARAM_REQUEST_BYTES - 1]) {
+        sendParamReply(command, PARAM_BAD_FRAME, effect, param, nullptr, 0);
+        return;
+    }
+
+    switch (command) {
+        case 'N': {
+            const ParamInfo *table;
+            payload[length++] = ActiveEffects::effectCount;
+            for (uint8_t i = 0; i < ActiveEffects::effectCount; i++) {
+                payload[length++] = ActiveEffects::params(i, table);
+            }
+            break;
+        }
+
+        case 'D': {
+            const ParamInfo *table;
+            if (param >= ActiveEffects::params(effect, table)) {
+                status = PARAM_UNKNOWN;
+                break;
+            }
+            ParamInfo info;
+            paramInfoRead(table, param, info);
+            payload[length++] = info.type;
+            payload[length++] = (uint8_t)info.min;
+            payload[length++] = (uint8_t)(info.min >> 8);
+            payload[length++] = (uint8_t)info.max;
+            payload[length++] = (uint8_t)(info.max >> 8);
+            payload[length++] = (uint8_t)info.def;
+            payload[length++] = (uint8_t)(info.def >> 8);
+            for (uint8_t i = 0; i < PARAM_NAME_CHARS; i++) {
+                payload[length++] = (uint8_t)info.name[i];
+            }
+            break;
+        }
+
+        case 'S':
+            // Reply with the value now live, whether or not it changed
+            status = ActiveEffects::paramSet(effectParamBanks, effect, param, value);
+            // fall through
+        case 'G': {
+            uint16_t live;
+            uint8_t getStatus = ActiveEffects::paramGet(effectParamBanks, effect, param, live);
+            if (getStatus != PARAM_OK) {
+                status = getStatus;
+                break;
+            }
+            payload[length++] = (uint8_t)live;
+            payload[length++] = (uint8_t)(live >> 8);
+            break;
+        }
+
+        case 'W': status = presetSave(effect); break;
+        case 'L': status = presetLoad(effect); break;
+
+        default:
+            status = PARAM_UNKNOWN;
+            break;
+    }
+    sendParamReply(command, status, effect, param, payload, length);
+}
+
+/**
+ * @brief: Runs every command waiting in the Serial receive buffer. Never waits for input:
+ * a parameter request split across passes of loop() is resumed on the next one.
+ * Called from loop().
+ */
+void serialCommandsPoll(void) {
+    if (requestLength && millis() - requestStartMs > SERIAL_FRAME_TIMEOUT_MS) {
+        requestLength = 0; // Incomplete request, drop it
+    }
+
+    while (Serial.available() > 0) {
+        int command = Serial.read();
+
+        if (requestLength) {
+            request[requestLength++] = (uint8_t)command;
+            if (requestLength == PARAM_REQUEST_BYTES) {
+                handleParamRequest();
+                requestLength = 0;
+            }
+            continue;
+        }
+
+        switch (command) {
+            case PARAM_SYNC:
+                request[0] = PARAM_SYNC;
+                requestLength = 1;
+                requestStartMs = millis();
+                break;
+#ifdef ISR_PROFILE
+            case 'p': isrProfilePrint(); break;
+            case 'r':
+                isrProfileReset();
+                Serial.println(F("ISR profile reset"));
+                break;
+#endif
+#ifdef TELEMETRY
+            case 'c': telemetryStartCapture(false); break;
+            case 't': telemetryStartCapture(true); break;
+#endif
+            default:
+                break;
+        }
+    }
+}
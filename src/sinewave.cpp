@@ -1,34 +1,28 @@
 #include "sinewave.h"
+#include "effects.h"
 #include <Arduino.h>
 
-#define SINE_TABLE_SIZE 256
+/*Voices loaded at boot: an A4 test tone on voice 0, the others muted.
+ * Call sinewaveSetVoice() to play chords, e.g. 4400 / 5544 / 6593 deciHz for A major.*/
+#define SINE_VOICE_PARAMS(voice, defaultDeciHz, defaultLevel) \
+    PARAM_ENTRY("sine.freq" #voice, PARAM_U16, SinewaveParams, frequency[voice], 0, 0xFFFF, defaultDeciHz), \
+    PARAM_ENTRY("sine.level" #voice, PARAM_Q15, SinewaveParams, level[voice], 0, Q15_MAX, defaultLevel)
 
-static const float SAMPLE_RATE_HZ = 1000000.0 / SAMPLE_RATE_MICROS;
-
-static int nSineTable[SINE_TABLE_SIZE];
-
-static float phase_accumulator = 0.0;
-static float frequency_step = 0.0;
-static int generated_sample = 0;
+static_assert(SINE_VOICES == 4, "sinewaveParamTable lists four voices");
+const ParamInfo sinewaveParamTable[SINEWAVE_PARAM_COUNT] PROGMEM = {
+    SINE_VOICE_PARAMS(0, 4400, FLOAT_TO_Q15(1.0)), // A4 (440 Hz)
+    SINE_VOICE_PARAMS(1, 0, 0),
+    SINE_VOICE_PARAMS(2, 0, 0),
+    SINE_VOICE_PARAMS(3, 0, 0),
+};
 
 /*********************************************FUNCTION DEFINITIONS****************************************************/
-void createSineTable(void){
-    for (uint16_t nIndex = 0; nIndex < SINE_TABLE_SIZE; nIndex++) {
-        nSineTable[nIndex] = (uint16_t)(((1.0 + sin(((2.0 * PI) / SINE_TABLE_SIZE) * nIndex)) * 1023.0) / 2.0);
-    }
-}
-
 void pinConfigSinewave(void){
     // No specific pins for Sinewave, common pins configured in main.cpp
 }
 
 void setupSinewave(void){
-    createSineTable();
-    Serial.println("SineWave Generator Ready!");
-
-    // Set a fixed frequency step for a perceivable sine wave
-    const float fixedFrequencyHz = 440.0; // A4 note (440 Hz)
-    frequency_step = (fixedFrequencyHz * SINE_TABLE_SIZE) / SAMPLE_RATE_HZ;
+    Serial.println(F("SineWave Generator Ready!"));
 }
 
 void loopSinewave(void){
@@ -36,60 +30,69 @@ void loopSinewave(void){
 }
 
 /**
- * @brief: Audio processing function for generating the sine wave.
- * This function is called by the universal ISR (TIMER1_CAPT_vect) from main.cpp.
- * It generates a sine wave using DDS and outputs it.
- * @param inputSample The raw 10-bit input audio sample (0-1023). This parameter is ignored
- * as the sine wave is generated internally, not processed from input.
+ * @brief: Restarts every voice at phase 0, so the tone starts from a zero crossing.
  */
-void processSinewaveAudio(int inputSample) { // inputSample parameter included for ISR consistency
-    float outputSampleFloat; // Use float for processing
-
-    if (effectActive) {
-        phase_accumulator += frequency_step;
-
-        while (phase_accumulator >= SINE_TABLE_SIZE) {
-            phase_accumulator -= SINE_TABLE_SIZE;
-        }
-        while (phase_accumulator < 0.0) { // Robustness, though frequency_step should be positive
-            phase_accumulator += SINE_TABLE_SIZE;
-        }
-
-        int idx1 = (int)phase_accumulator;
-        float fraction = phase_accumulator - idx1;
-        int idx2 = (idx1 + 1) % SINE_TABLE_SIZE;
-
-        int sample1 = nSineTable[idx1];
-        int sample2 = nSineTable[idx2];
-
-        // Interpolate between sample1 and sample2 to get the final sine sample
-        // These samples are already 0-1023 range, which is perfect for direct output.
-        generated_sample = (int)(sample1 + fraction * (sample2 - sample1));
-        
-        outputSampleFloat = (float)generated_sample - 511.5; // Center for volume application
-    }
-    else {
-        // If generator is off, output silence (midpoint of 10-bit range) and reset phase
-        outputSampleFloat = 0.0; // Centered silence
-        phase_accumulator = 0.0; // Reset phase for clean restart
+void restartSinewave(void){
+    SinewaveEffect::State &state = effectState<SinewaveEffect>();
+    for (uint8_t i = 0; i < SINE_VOICES; i++) {
+        state.phase[i] = 0;
     }
+}
 
-    // --- Final Output Processing ---
-    // Apply Amplitude/Volume control from global pot2_value
-    float amplitude_factor = pot2_value / 1023.0;
-    outputSampleFloat *= amplitude_factor; // Apply volume to the centered signal
-
-    // Re-bias the processed sample to 0-1023 range
-    int finalOutputSample = (int)(outputSampleFloat + 511.5);
+/**
+ * @brief: Converts every voice frequency to its phase step. Runs in loop() when a setting changes.
+ */
+void deriveSinewaveParams(SinewaveParams &params) {
+    for (uint8_t i = 0; i < SINE_VOICES; i++) {
+        params.step[i] = (uint32_t)params.frequency[i] * SINE_STEP_PER_DECIHERTZ;
+    }
+}
 
-    // Constrain the final output to the valid 10-bit range (0-1023)
-    finalOutputSample = constrain(finalOutputSample, 0, 1023);
+/**
+ * @brief: Tunes one voice. Frequency and level are published together, so the ISR never
+ * plays the new pitch at the old level. Safe to call while the ISR is running.
+ * @param voice Voice number, 0 to SINE_VOICES - 1.
+ * @param frequencyDeciHz Frequency in 0.1 Hz steps (4400 = 440 Hz).
+ * @param level Voice amplitude in Q15. The levels of all voices should add up to at most
+ * Q15_MAX, otherwise chord peaks clip.
+ */
+void sinewaveSetVoice(uint8_t voice, uint16_t frequencyDeciHz, q15_t level) {
+    if (voice >= SINE_VOICES) return;
+    ParamBank<SinewaveParams> &bank = effectParams<SinewaveEffect>();
+    SinewaveParams &next = bank.stage();
+    next.frequency[voice] = frequencyDeciHz;
+    next.level[voice] = level;
+    deriveSinewaveParams(next);
+    bank.publish();
+}
 
-    // // Split for dual PWM output
-    // analogWrite(AUDIO_OUT_A, finalOutputSample / 4);
-    // analogWrite(AUDIO_OUT_B, map(finalOutputSample % 4, 0, 3, 0, 255));
+/**
+ * @brief: Audio processing function for generating the sine wave.
+ * This function is called by the universal ISR (TIMER1_CAPT_vect) from main.cpp.
+ * It sums SINE_VOICES DDS oscillators and returns the result.
+ * @param inputSample The centered Q15 input audio sample. This parameter is ignored
+ * as the sine wave is generated internally, not processed from input.
+ * @return The generated Q15 sample, before master volume.
+ */
+q15_t processSinewaveAudio(q15_t inputSample) { // inputSample parameter included for ISR consistency
+    (void)inputSample;
+    SinewaveEffect::State &state = effectState<SinewaveEffect>();
+    const SinewaveParams &params = effectParams<SinewaveEffect>().live();
+
+    int32_t mix = 0;
+    for (uint8_t i = 0; i < SINE_VOICES; i++) {
+        uint32_t phase = state.phase[i] + params.step[i]; // Wraps around the table for free
+        state.phase[i] = phase;
+
+        // Top byte indexes the table, the next byte is the interpolation fraction
+        uint16_t phaseHigh = (uint16_t)(phase >> 16);
+        const q15_t *entry = &sineTable[phaseHigh >> 8];
+        q15_t sample1 = (q15_t)pgm_read_word(entry);
+        q15_t sample2 = (q15_t)pgm_read_word(entry + 1); // Guard entry covers the wrap
+        q15_t sine = sample1 + (q15_t)((((int32_t)sample2 - sample1) * (uint8_t)phaseHigh) >> 8);
+
+        mix += (int32_t)sine * params.level[i];
+    }
 
-    /*write the PWM output signal*/
-    OCR1AL = ((finalOutputSample + 0x8000) >> 8); // convert to unsigned, send out high byte
-    OCR1BL = finalOutputSample; // send out low byte
+    return q15Saturate(mix >> 15);
 }
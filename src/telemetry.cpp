@@ -0,0 +1,90 @@
+#include "telemetry.h"
+#include "arena.h"
+#include <Arduino.h>
+
+#ifdef TELEMETRY
+TelemetryRing telemetryRing;
+TelemetryCapture telemetryCapture;
+
+static_assert(sizeof(telemetryRing) + sizeof(telemetryCapture) <= TELEMETRY_SRAM_BYTES + SRAM_HOST_PADDING_BYTES,
+              "Telemetry state outgrew TELEMETRY_SRAM_BYTES (arena.h)");
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Empties the ring and idles the capture. Called once in setup(),
+ * before the ISR starts.
+ */
+void telemetrySetup(void) {
+    telemetryRing.head = 0;
+    telemetryRing.tail = 0;
+    telemetryRing.dropped = 0;
+    telemetryCapture.remaining = 0;
+    telemetryCapture.armed = false;
+    telemetryCapture.lastMode = CLEAN_MODE;
+    telemetryCapture.overruns = 0;
+}
+
+/**
+ * @brief: Arms a capture of TELEMETRY_CAPTURE_SAMPLES sample records. A running
+ * capture is restarted.
+ * @param onLevel true to wait for an input sample of at least TELEMETRY_TRIGGER_LEVEL,
+ * false to start on the next sample.
+ */
+void telemetryStartCapture(bool onLevel) {
+    uint8_t oldSREG = SREG;
+    cli();
+    telemetryCapture.remaining = 0;
+    telemetryCapture.triggerLevel = onLevel ? TELEMETRY_TRIGGER_LEVEL : 0;
+    telemetryCapture.armed = true;
+    SREG = oldSREG;
+}
+
+/**
+ * @brief: Queues one frame in the Serial transmit buffer.
+ */
+static void telemetrySendFrame(uint8_t type, int16_t a, int16_t b) {
+    uint8_t frame[TELEMETRY_FRAME_BYTES];
+    frame[0] = TELEMETRY_SYNC;
+    frame[1] = type;
+    frame[2] = (uint8_t)a;
+    frame[3] = (uint8_t)((uint16_t)a >> 8);
+    frame[4] = (uint8_t)b;
+    frame[5] = (uint8_t)((uint16_t)b >> 8);
+    uint8_t checksum = 0;
+    for (uint8_t i = 1; i < TELEMETRY_FRAME_BYTES - 1; i++) {
+        checksum += frame[i];
+    }
+    frame[TELEMETRY_FRAME_BYTES - 1] = checksum;
+    for (uint8_t i = 0; i < TELEMETRY_FRAME_BYTES; i++) {
+        Serial.write(frame[i]);
+    }
+}
+
+/**
+ * @brief: Consumer side of the ring. Sends as many records as the transmit buffer
+ * has room for and returns; anything left waits for the next pass of loop().
+ * Called from loop().
+ */
+void telemetryService(void) {
+    while (Serial.availableForWrite() >= TELEMETRY_FRAME_BYTES) {
+        uint8_t tail = telemetryRing.tail;
+        if (tail == telemetryRing.head) {
+            break;
+        }
+        const TelemetryRecord *record = &telemetryRing.records[tail];
+        telemetrySendFrame(record->type, record->a, record->b);
+        __asm__ __volatile__("" ::: "memory"); // Finish reading the slot before handing it back
+        telemetryRing.tail = (tail + 1) & TELEMETRY_RING_MASK;
+    }
+
+    // Report losses once the backlog is gone, so the report follows the gap
+    if (telemetryRing.dropped && Serial.availableForWrite() >= TELEMETRY_FRAME_BYTES) {
+        uint8_t oldSREG = SREG;
+        cli();
+        uint16_t dropped = telemetryRing.dropped;
+        telemetryRing.dropped = 0;
+        SREG = oldSREG;
+        telemetrySendFrame(TELEMETRY_DROPPED, (int16_t)dropped, 0);
+    }
+}
+#endif
@@ -0,0 +1,223 @@
+#include "transition.h"
+#include "effectchain.h"
+#include <Arduino.h>
+
+#define TRANSITION_DIP_SAMPLES (TRANSITION_FADE_SAMPLES / 2)
+
+/*Ramp steps, rounded up so the fade always reaches its end value in time*/
+static constexpr q15_t TRANSITION_FADE_STEP = (Q15_MAX + TRANSITION_FADE_SAMPLES - 1) / TRANSITION_FADE_SAMPLES;
+static constexpr q15_t TRANSITION_DIP_STEP = (Q15_MAX + TRANSITION_DIP_SAMPLES - 1) / TRANSITION_DIP_SAMPLES;
+static constexpr q15_t TRANSITION_TAIL_STEP = (Q15_MAX + TRANSITION_TAIL_SAMPLES - 1) / TRANSITION_TAIL_SAMPLES;
+
+static_assert(TRANSITION_DIP_SAMPLES >= 1, "TRANSITION_FADE_MS is too short for a dip");
+static_assert(TRANSITION_TAIL_MS * AUDIO_SAMPLE_RATE_HZ / 1000.0 < 65536.0, "TRANSITION_TAIL_MS exceeds the 16-bit sample counter");
+
+Transition transition = {NORMAL_MODE, 0, 0, 0, TRANSITION_IDLE, false, false};
+static EffectMode targetMode = NORMAL_MODE; // Last mode asked for by transitionTo()
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Effects used by mode, one bit each (see EffectRegistry::effectMask()).
+ */
+static uint8_t transitionEffectMask(EffectMode mode) {
+    if (mode != CHAIN_MODE) {
+        return ActiveEffects::effectMask(mode);
+    }
+    uint8_t mask = 0;
+    for (uint8_t stage = 0; stage < effectChainLength; stage++) {
+        mask |= ActiveEffects::effectMask(effectChain[stage]);
+    }
+    return mask;
+}
+
+/**
+ * @brief: Declared worst-case cycles of mode, including the chain dispatch in CHAIN_MODE.
+ */
+static uint32_t transitionCycles(EffectMode mode) {
+    if (mode == CHAIN_MODE) {
+        uint32_t cycles = 0;
+        for (uint8_t stage = 0; stage < effectChainLength; stage++) {
+            cycles += effectChainCycles(&effectChain[stage], 1);
+        }
+        return cycles;
+    }
+    return ActiveEffects::cycles(mode);
+}
+
+/**
+ * @brief: Restarts the effects of mode before its first sample. Constant time.
+ * Only used when the outgoing mode shared an effect with mode: its State then holds what
+ * the outgoing mode left. Otherwise the lines are kept, so switching back to an effect
+ * resumes its tail.
+ */
+static inline void transitionRestart(EffectMode mode) {
+    if (mode == CHAIN_MODE) {
+        for (uint8_t stage = 0; stage < effectChainLength; stage++) {
+            ActiveEffects::restart(effectChain[stage]);
+        }
+    } else {
+        ActiveEffects::restart(mode);
+    }
+}
+
+/**
+ * @brief: Sets the starting mode without a transition. Called at the end of setup().
+ */
+void transitionSetup(EffectMode mode) {
+    uint8_t oldSREG = SREG;
+    cli();
+    transition.phase = TRANSITION_IDLE;
+    targetMode = mode;
+    currentActiveMode = mode;
+    SREG = oldSREG;
+}
+
+/**
+ * @brief: Asks for a switch to mode. It starts now, or as soon as the running transition
+ * allows (see transitionService()). Called from loop().
+ */
+void transitionTo(EffectMode mode) {
+    targetMode = mode;
+    transitionService();
+}
+
+/**
+ * @brief: The mode the pedal is on or heading to.
+ */
+EffectMode transitionTarget(void) {
+    return targetMode;
+}
+
+/**
+ * @brief: Starts the transition to the requested mode once the previous one allows it.
+ * Picks a crossfade, a dip or a cut by the effects the two modes use and their cost.
+ * Called from loop().
+ */
+void transitionService(void) {
+    EffectMode from = currentActiveMode;
+    EffectMode to = targetMode;
+    if (to == from) return;
+
+    if (transition.phase == TRANSITION_TAIL) {
+        // Shorten a ringing tail to a quick fade-out, then switch
+        uint8_t oldSREG = SREG;
+        cli();
+        if (transition.phase == TRANSITION_TAIL && transition.remaining > TRANSITION_FADE_SAMPLES) {
+            transition.remaining = TRANSITION_FADE_SAMPLES;
+            transition.step = (transition.fade + TRANSITION_FADE_SAMPLES - 1) / TRANSITION_FADE_SAMPLES;
+        }
+        SREG = oldSREG;
+        return;
+    }
+    if (transition.phase != TRANSITION_IDLE) return;
+
+    uint32_t fromCycles = transitionCycles(from);
+    uint32_t toCycles = transitionCycles(to);
+    bool shared = transitionEffectMask(from) & transitionEffectMask(to);
+    bool crossfade = !shared && fromCycles + toCycles + TRANSITION_MIX_CYCLES <= EFFECT_CHAIN_BUDGET_CYCLES;
+    bool dip = ((fromCycles > toCycles) ? fromCycles : toCycles) + TRANSITION_MIX_CYCLES <= EFFECT_CHAIN_BUDGET_CYCLES;
+
+    uint8_t oldSREG = SREG;
+    cli();
+    transition.from = from;
+    if (crossfade) {
+        transition.phase = TRANSITION_CROSSFADE;
+        transition.remaining = TRANSITION_FADE_SAMPLES;
+        transition.fade = 0;
+        transition.step = TRANSITION_FADE_STEP;
+        transition.restartPending = false; // Nothing shared, nothing to restart
+#ifdef TRANSITION_TAILS
+        transition.tail = true;
+#else
+        transition.tail = false;
+#endif
+    } else if (dip) {
+        transition.phase = TRANSITION_DIP_OUT;
+        transition.remaining = TRANSITION_DIP_SAMPLES;
+        transition.fade = Q15_MAX;
+        transition.step = TRANSITION_DIP_STEP;
+        transition.restartPending = shared;
+    } else if (shared) {
+        transitionRestart(to); // The ISR is held off, so the outgoing mode is not running
+    }
+    currentActiveMode = to;
+    SREG = oldSREG;
+}
+
+/**
+ * @brief: ISR side of a transition: renders one sample and advances the ramp.
+ * Kept out of line, so its calls to processAudioSample() stay calls: flattening them
+ * into the ISR would copy every kernel once per call site.
+ * @param mode The incoming mode (currentActiveMode).
+ * @param inputSample The centered Q15 input audio sample.
+ * @return The processed Q15 sample, before master volume.
+ */
+__attribute__((noinline)) q15_t transitionRun(EffectMode mode, q15_t inputSample) {
+    q15_t outputSample;
+    q15_t fade = transition.fade;
+
+    switch (transition.phase) {
+        case TRANSITION_CROSSFADE: {
+            fade = (fade < Q15_MAX - transition.step) ? fade + transition.step : Q15_MAX;
+            q15_t incoming = processAudioSample(mode, inputSample);
+            if (transition.tail) {
+                // Only the input of the outgoing mode fades: whatever its lines hold keeps playing
+                q15_t outgoing = processAudioSample(transition.from, q15Mul(inputSample, Q15_MAX - fade));
+                outputSample = q15Add(outgoing, q15Mul(incoming, fade));
+            } else {
+                outputSample = q15Mix(processAudioSample(transition.from, inputSample), incoming, fade);
+            }
+            if (--transition.remaining == 0) {
+                if (transition.tail) {
+                    transition.phase = TRANSITION_TAIL;
+                    transition.remaining = TRANSITION_TAIL_SAMPLES;
+                    transition.step = TRANSITION_TAIL_STEP;
+                    fade = Q15_MAX; // From here on the outgoing level
+                } else {
+                    transition.phase = TRANSITION_IDLE;
+                }
+            }
+            break;
+        }
+
+        case TRANSITION_TAIL: {
+            fade = (fade > transition.step) ? fade - transition.step : 0;
+            q15_t ringing = q15Mul(processAudioSample(transition.from, 0), fade);
+            outputSample = q15Add(processAudioSample(mode, inputSample), ringing);
+            if (--transition.remaining == 0) {
+                transition.phase = TRANSITION_IDLE;
+            }
+            break;
+        }
+
+        case TRANSITION_DIP_OUT: {
+            fade = (fade > transition.step) ? fade - transition.step : 0;
+            outputSample = q15Mul(processAudioSample(transition.from, inputSample), fade);
+            if (--transition.remaining == 0) {
+                transition.phase = TRANSITION_DIP_IN;
+                transition.remaining = TRANSITION_DIP_SAMPLES;
+            }
+            break;
+        }
+
+        case TRANSITION_DIP_IN: {
+            if (transition.restartPending) {
+                transitionRestart(mode);
+                transition.restartPending = false;
+            }
+            fade = (fade < Q15_MAX - transition.step) ? fade + transition.step : Q15_MAX;
+            outputSample = q15Mul(processAudioSample(mode, inputSample), fade);
+            if (--transition.remaining == 0) {
+                transition.phase = TRANSITION_IDLE;
+            }
+            break;
+        }
+
+        default:
+            outputSample = processAudioSample(mode, inputSample);
+            break;
+    }
+
+    transition.fade = fade;
+    return outputSample;
+}
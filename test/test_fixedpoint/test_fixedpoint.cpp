@@ -0,0 +1,130 @@
+/* Accuracy of the Q15 fixed-point core (fixedpoint.h) against the float expressions the
+ * original kernels used (pio test -e native).
+ * Every check runs FIXEDPOINT_TRIALS random 10-bit inputs through one helper and through
+ * its float counterpart, centered on 511.5 as the float kernels were, and bounds the
+ * largest difference in 10-bit LSBs. Half an LSB of every bound is that centering: Q15
+ * centers on 512.*/
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+#include "fixedpoint.h"
+
+#define FIXEDPOINT_TRIALS 200000UL
+
+/*Float kernel constants of the original effects*/
+#define FLOAT_REVERB_MIX 0.70
+#define FLOAT_ECHO_FEEDBACK 0.65
+#define FLOAT_DISTORTION_GAIN 3.5
+#define FLOAT_DISTORTION_THRESHOLD 150.0
+
+/*Largest errors allowed, in 10-bit LSBs*/
+#define MIX_MAX_ERROR 0.55
+#define FEEDBACK_MAX_ERROR 0.85
+#define VOLUME_MAX_ERROR 1.02    // Includes the old kernel's int truncation; the multiply alone is ~0.55
+#define GAIN_CLIP_MAX_ERROR 1.76 // The centering times the 3.5x pre-gain
+
+static uint32_t randomState = 1;
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Next 10-bit code (0-1023) from a fixed-seed LCG, so failures reproduce.
+ */
+static uint16_t randomCode(void) {
+    randomState = randomState * 1664525UL + 1013904223UL;
+    return (uint16_t)(randomState >> 22);
+}
+
+static double centered(uint16_t code) { return code - 511.5; }
+
+static double lsb(q15_t x) { return x / 64.0; } // Q15 to centered 10-bit units
+
+static void checkBound(double worst, double bound, const char *what) {
+    char message[64];
+    snprintf(message, sizeof(message), "%s: %.3f LSB, bound %.2f", what, worst, bound);
+    TEST_ASSERT_TRUE_MESSAGE(worst <= bound, message);
+}
+
+/**
+ * @brief: REVERB-style wet/dry mix, dry * (1 - a) + wet * a, through q15Mix().
+ */
+void test_mix(void) {
+    double worst = 0.0;
+    for (uint32_t i = 0; i < FIXEDPOINT_TRIALS; i++) {
+        uint16_t dry = randomCode(), wet = randomCode();
+        double expected = centered(dry) * (1.0 - FLOAT_REVERB_MIX) + centered(wet) * FLOAT_REVERB_MIX;
+        q15_t actual = q15Mix(q15From10Bit(dry), q15From10Bit(wet), FLOAT_TO_Q15(FLOAT_REVERB_MIX));
+        worst = fmax(worst, fabs(lsb(actual) - expected));
+    }
+    checkBound(worst, MIX_MAX_ERROR, "mix");
+}
+
+/**
+ * @brief: ECHO feedback, input + delayed * feedback, through q15Add() and q15Mul().
+ * Inputs are halved so the float sum stays in range, as it does in the kernel's use.
+ */
+void test_feedback(void) {
+    double worst = 0.0;
+    for (uint32_t i = 0; i < FIXEDPOINT_TRIALS; i++) {
+        uint16_t input = 256 + randomCode() / 2, delayed = 256 + randomCode() / 2;
+        double expected = centered(input) + centered(delayed) * FLOAT_ECHO_FEEDBACK;
+        q15_t actual = q15Add(q15From10Bit(input), q15Mul(q15From10Bit(delayed), FLOAT_TO_Q15(FLOAT_ECHO_FEEDBACK)));
+        worst = fmax(worst, fabs(lsb(actual) - expected));
+    }
+    checkBound(worst, FEEDBACK_MAX_ERROR, "feedback");
+}
+
+/**
+ * @brief: A linear volume, sample * volume / 1023, through q15Mul() with a Q15 gain.
+ */
+void test_volume(void) {
+    double worst = 0.0;
+    for (uint32_t i = 0; i < FIXEDPOINT_TRIALS; i++) {
+        uint16_t code = randomCode(), volume = randomCode();
+        double expected = centered(code) * volume / 1023.0;
+        q15_t gain = q15Saturate((int32_t)volume * 32767 / 1023);
+        worst = fmax(worst, fabs(lsb(q15Mul(q15From10Bit(code), gain)) - expected));
+    }
+    checkBound(worst, VOLUME_MAX_ERROR, "volume");
+}
+
+/**
+ * @brief: DISTORTION-style pre-gain and hard clip, through q15Gain() and q15Clip().
+ */
+void test_gain_clip(void) {
+    double worst = 0.0;
+    for (uint32_t i = 0; i < FIXEDPOINT_TRIALS; i++) {
+        uint16_t code = randomCode();
+        double expected = fmax(-FLOAT_DISTORTION_THRESHOLD, fmin(FLOAT_DISTORTION_THRESHOLD, centered(code) * FLOAT_DISTORTION_GAIN));
+        q15_t actual = q15Clip(q15Gain(q15From10Bit(code), FLOAT_TO_Q7_8(FLOAT_DISTORTION_GAIN)),
+                               SAMPLE10_TO_Q15(FLOAT_DISTORTION_THRESHOLD));
+        worst = fmax(worst, fabs(lsb(actual) - expected));
+    }
+    checkBound(worst, GAIN_CLIP_MAX_ERROR, "gain and clip");
+}
+
+/**
+ * @brief: The conversions are exact: every 10-bit code survives Q15 and back, and the
+ * ADC word maps onto the same Q15 value.
+ */
+void test_conversions(void) {
+    for (uint16_t code = 0; code < 1024; code++) {
+        q15_t sample = q15From10Bit(code);
+        TEST_ASSERT_EQUAL_UINT16(code, q15To10Bit(sample));
+        uint16_t adc = code << 6; // Left adjusted
+        TEST_ASSERT_EQUAL_INT16(sample, q15FromAdc(adc & 0xFF, adc >> 8));
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    (void)argc; (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_mix);
+    RUN_TEST(test_feedback);
+    RUN_TEST(test_volume);
+    RUN_TEST(test_gain_clip);
+    RUN_TEST(test_conversions);
+    return UNITY_END();
+}
@@ -0,0 +1,250 @@
+/* Generated by tools/gen_golden.py - edit the script, not this file.*/
+#ifndef GOLDEN_H
+#define GOLDEN_H
+#include "main.h"
+#include "signals.h"
+
+#define GOLDEN_SAMPLE_RATE_HZ 31372UL // Of the build that made this file
+#define GOLDEN_HEAD 32   // Leading output samples kept
+#define GOLDEN_STRIDE 128 // Then one sample in GOLDEN_STRIDE, from GOLDEN_STRIDE / 2
+#define GOLDEN_POINTS 32
+#define GOLDEN_WINDOW 256 // RMS window, samples
+#define GOLDEN_WINDOWS 16
+
+/*Output summary of one mode on one signal, in 10-bit codes centered on 512*/
+struct GoldenCase {
+    EffectMode mode;
+    uint8_t signal; // GoldenSignal
+    int16_t head[GOLDEN_HEAD];
+    int16_t points[GOLDEN_POINTS];
+    uint16_t rms[GOLDEN_WINDOWS]; // Tenths of a code
+};
+
+static const GoldenCase goldenCases[] = {
+    {CLEAN_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 510, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {319, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {CLEAN_MODE, SIGNAL_SWEEP,
+     {0, 4, 10, 16, 22, 28, 34, 40, 47, 53, 60, 66, 73, 79, 86, 93, 100, 107, 114, 121, 128, 135, 142, 149, 156, 164, 171, 178, 185, 193, 200, 207},
+     {411, 35, 97, -191, 440, -343, -301, 437, 157, 414, -420, -194, -425, 232, 264, -447, 19, -270, 191, -286, 307, -424, -365, -121, -385, -442, 378, -143, 345, -409, -269, -331},
+     {3137, 3323, 3244, 3270, 3274, 3259, 3273, 3265, 3263, 3276, 3259, 3267, 3272, 3266, 3263, 3265}},
+    {CLEAN_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {CLEAN_MODE, SIGNAL_FULL_SCALE,
+     {510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510},
+     {-512, -512, 510, 510, 510, -512, -512, 510, 510, -512, -512, 510, 510, 510, -512, -512, 510, 510, -512, -512, 510, 510, 510, -512, -512, 510, 510, -512, -512, 510, 510, 510},
+     {5109, 5111, 5109, 5110, 5110, 5110, 5111, 5109, 5111, 5109, 5111, 5109, 5110, 5110, 5110, 5111}},
+    {NORMAL_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 510, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {319, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {NORMAL_MODE, SIGNAL_SWEEP,
+     {0, 4, 10, 16, 22, 28, 34, 40, 47, 53, 60, 66, 73, 79, 86, 93, 100, 107, 114, 121, 128, 135, 142, 149, 156, 164, 171, 178, 185, 193, 200, 207},
+     {411, 35, 97, -191, 440, -343, -301, 437, 157, 414, -420, -194, -425, 232, 264, -447, 19, -270, 191, -286, 307, -424, -365, -121, -385, -442, 378, -143, 345, -409, -269, -331},
+     {3137, 3323, 3244, 3270, 3274, 3259, 3273, 3265, 3263, 3276, 3259, 3267, 3272, 3266, 3263, 3265}},
+    {NORMAL_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {NORMAL_MODE, SIGNAL_FULL_SCALE,
+     {510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510},
+     {-512, -512, 510, 510, 510, -512, -512, 510, 510, -512, -512, 510, 510, 510, -512, -512, 510, 510, -512, -512, 510, 510, 510, -512, -512, 510, 510, -512, -512, 510, 510, 510},
+     {5109, 5111, 5109, 5110, 5110, 5110, 5111, 5109, 5111, 5109, 5111, 5109, 5110, 5110, 5110, 5111}},
+    {REVERB_ECHO_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 255, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, -3, 2, -6, -5, 2, 0, -3, 6, 0, 5, 5, -3, 1, -3, 0, 0, 5, 1, 0, 2, 0, -2, 1, 0, 0, -3},
+     {159, 21, 57, 31, 38, 32, 27, 23, 25, 16, 19, 18, 17, 17, 13, 13}},
+    {REVERB_ECHO_MODE, SIGNAL_SWEEP,
+     {0, 2, 5, 8, 11, 14, 17, 20, 23, 26, 30, 33, 36, 39, 43, 46, 50, 53, 57, 60, 64, 67, 71, 74, 78, 82, 85, 89, 92, 96, 100, 103},
+     {205, 17, 48, -93, 264, -193, -310, 123, 95, 372, -237, -218, -191, 287, 303, -53, -161, -151, 145, -139, -17, -42, -102, -93, -330, -195, 324, -88, 118, -196, 4, -180},
+     {1568, 1656, 2096, 2031, 2073, 1938, 1966, 1962, 1888, 1929, 1833, 1878, 1924, 1885, 1910, 1876}},
+    {REVERB_ECHO_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {REVERB_ECHO_MODE, SIGNAL_FULL_SCALE,
+     {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+     {-256, -256, 255, 340, 169, -427, -427, 340, 426, -342, -427, 340, 426, 426, -342, -427, 240, 426, -194, -427, 264, 426, 426, -342, -427, 340, 426, -342, -427, 298, 426, 426},
+     {2554, 2662, 3694, 3749, 3772, 3745, 3701, 3617, 3404, 3492, 3653, 3661, 3679, 3677, 3691, 3648}},
+    {DELAY_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 510, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {451, 327, 125, 69, 38, 20, 11, 5, 2, 1, 0, 0, 0, 0, 0, 0}},
+    {DELAY_MODE, SIGNAL_SWEEP,
+     {0, 4, 10, 16, 22, 28, 34, 40, 47, 53, 60, 66, 73, 79, 86, 93, 100, 107, 114, 121, 128, 135, 142, 149, 156, 164, 171, 178, 185, 193, 200, 207},
+     {411, 458, 511, 147, 274, -218, -512, -74, 175, 10, -512, -512, -138, 292, 511, 63, -452, 210, 511, -512, -204, -469, 91, 389, -512, 68, 511, -512, 511, -512, 218, -294},
+     {3273, 4081, 3697, 3876, 4020, 3918, 3879, 3810, 4013, 3932, 3960, 3710, 3984, 3954, 3963, 3773}},
+    {DELAY_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {DELAY_MODE, SIGNAL_FULL_SCALE,
+     {510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510},
+     {-512, -512, -1, 511, 511, -1, -512, -1, 511, -1, -512, -1, 511, 511, -1, -512, -1, 511, -1, -512, -1, 511, 511, -1, -512, -1, 511, -1, -512, -1, 511, 511},
+     {4298, 3657, 3657, 3657, 3615, 3600, 3601, 3600, 3617, 3656, 3657, 3657, 3657, 3615, 3600, 3601}},
+    {ECHO_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 510, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0},
+     {319, 319, 207, 134, 86, 56, 0, 36, 22, 14, 9, 5, 2, 0, 1, 0}},
+    {ECHO_MODE, SIGNAL_SWEEP,
+     {0, 4, 10, 16, 22, 28, 34, 40, 47, 53, 60, 66, 73, 79, 86, 93, 100, 107, 114, 121, 128, 135, 142, 149, 156, 164, 171, 178, 185, 193, 200, 207},
+     {411, 35, 226, -512, 148, -512, 209, 511, 511, 511, -512, 274, -512, 511, 453, 40, 113, 240, 136, 214, 326, -14, -512, 259, -512, -137, 511, 367, 431, -512, -119, -101},
+     {3137, 3313, 3878, 3835, 3773, 3793, 3759, 3727, 3737, 3724, 3726, 3716, 3740, 3741, 3724, 3731}},
+    {ECHO_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {ECHO_MODE, SIGNAL_FULL_SCALE,
+     {510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510},
+     {-512, -512, 511, 511, -1, -512, -1, 511, -1, -512, -512, 511, 511, -1, -512, -1, 511, -1, -512, -512, 511, 511, -1, -512, -1, 511, -1, -512, -512, 511, 511, -1},
+     {5109, 4383, 4143, 4193, 4192, 4193, 4193, 4192, 4193, 4143, 4144, 4143, 4193, 4192, 4193, 4193}},
+    {OCTAVER_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 511, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, -2},
+     {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {320, 10, 10, 10, 10, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {OCTAVER_MODE, SIGNAL_SWEEP,
+     {0, 2, 5, 8, 11, 43, 52, 61, 71, 80, 90, 99, 109, 118, 129, 139, 149, 159, 170, 180, 190, 200, 210, 221, 231, 242, 252, 263, 273, 284, 294, 304},
+     {511, -38, 19, -203, 60, -270, -262, 44, 60, 444, -305, -44, 118, -62, 219, -313, -149, 9, -83, 21, 282, 117, 75, -216, 90, 131, 389, -79, -7, 107, -260, -279},
+     {2931, 2305, 2325, 2201, 2267, 2214, 2276, 2264, 2250, 2258, 2282, 2266, 2228, 2286, 2261, 2270}},
+    {OCTAVER_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {OCTAVER_MODE, SIGNAL_FULL_SCALE,
+     {511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511, 511},
+     {-223, -317, 511, 511, -20, 70, 63, -45, -48, -458, -459, 460, 460, -52, 51, 51, -52, -52, -461, -461, 459, 459, -52, 51, 51, -52, -52, -461, -461, 459, 459, -52},
+     {3343, 3503, 3142, 3058, 3333, 3467, 3311, 3066, 3134, 3467, 3467, 3106, 3068, 3335, 3467, 3310}},
+    {DISTORTION_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 149, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+     {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {94, 10, 10, 10, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {DISTORTION_MODE, SIGNAL_SWEEP,
+     {0, 17, 37, 56, 72, 87, 99, 109, 118, 124, 130, 133, 136, 138, 139, 140, 140, 140, 140, 140, 140, 140, 139, 139, 138, 138, 137, 137, 136, 135, 135, 134},
+     {118, 92, 121, -165, 142, -156, -154, 148, 146, 148, -149, -148, -150, 151, 150, -150, 67, -148, 149, -150, 149, -149, -146, -148, -148, -149, 149, -150, 150, -147, -148, -150},
+     {1386, 1473, 1455, 1463, 1454, 1459, 1455, 1444, 1446, 1459, 1459, 1455, 1446, 1452, 1443, 1457}},
+    {DISTORTION_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {DISTORTION_MODE, SIGNAL_FULL_SCALE,
+     {149, 148, 147, 147, 146, 146, 145, 145, 144, 143, 143, 142, 142, 141, 141, 140, 140, 139, 138, 138, 137, 137, 136, 136, 135, 135, 134, 134, 133, 133, 132, 132},
+     {-152, -158, 137, 148, 158, -149, -158, 145, 154, -144, -153, 140, 149, 159, -148, -158, 145, 154, -143, -153, 140, 149, 159, -148, -158, 145, 154, -143, -153, 140, 149, 159},
+     {1486, 1497, 1492, 1493, 1492, 1492, 1492, 1491, 1492, 1493, 1494, 1493, 1493, 1492, 1492, 1492}},
+    {SINEWAVE_MODE, SIGNAL_IMPULSE,
+     {45, 89, 133, 176, 218, 258, 296, 331, 364, 394, 422, 445, 466, 483, 496, 505, 510, 511, 509, 502, 492, 477, 459, 438, 412, 384, 353, 319, 283, 244, 204, 161},
+     {-270, -494, -7, 489, 280, -333, -467, 71, 506, 212, -388, -430, 146, 511, 139, -434, -383, 219, 505, 63, -470, -327, 286, 487, -14, -496, -264, 347, 458, -91, -510, -195},
+     {3585, 3629, 3662, 3646, 3600, 3576, 3604, 3649, 3661, 3626, 3582, 3584, 3625, 3661, 3649, 3602}},
+    {SINEWAVE_MODE, SIGNAL_SWEEP,
+     {45, 89, 133, 176, 218, 258, 296, 331, 364, 394, 422, 445, 466, 483, 496, 505, 510, 511, 509, 502, 492, 477, 459, 438, 412, 384, 353, 319, 283, 244, 204, 161},
+     {-270, -494, -7, 489, 280, -333, -467, 71, 506, 212, -388, -430, 146, 511, 139, -434, -383, 219, 505, 63, -470, -327, 286, 487, -14, -496, -264, 347, 458, -91, -510, -195},
+     {3585, 3629, 3662, 3646, 3600, 3576, 3604, 3649, 3661, 3626, 3582, 3584, 3625, 3661, 3649, 3602}},
+    {SINEWAVE_MODE, SIGNAL_SILENCE,
+     {45, 89, 133, 176, 218, 258, 296, 331, 364, 394, 422, 445, 466, 483, 496, 505, 510, 511, 509, 502, 492, 477, 459, 438, 412, 384, 353, 319, 283, 244, 204, 161},
+     {-270, -494, -7, 489, 280, -333, -467, 71, 506, 212, -388, -430, 146, 511, 139, -434, -383, 219, 505, 63, -470, -327, 286, 487, -14, -496, -264, 347, 458, -91, -510, -195},
+     {3585, 3629, 3662, 3646, 3600, 3576, 3604, 3649, 3661, 3626, 3582, 3584, 3625, 3661, 3649, 3602}},
+    {SINEWAVE_MODE, SIGNAL_FULL_SCALE,
+     {45, 89, 133, 176, 218, 258, 296, 331, 364, 394, 422, 445, 466, 483, 496, 505, 510, 511, 509, 502, 492, 477, 459, 438, 412, 384, 353, 319, 283, 244, 204, 161},
+     {-270, -494, -7, 489, 280, -333, -467, 71, 506, 212, -388, -430, 146, 511, 139, -434, -383, 219, 505, 63, -470, -327, 286, 487, -14, -496, -264, 347, 458, -91, -510, -195},
+     {3585, 3629, 3662, 3646, 3600, 3576, 3604, 3649, 3661, 3626, 3582, 3584, 3625, 3661, 3649, 3602}},
+    {CHORUS_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 255, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {196, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {CHORUS_MODE, SIGNAL_SWEEP,
+     {0, 2, 5, 8, 11, 14, 17, 20, 23, 26, 30, 33, 36, 39, 43, 46, 50, 53, 57, 60, 64, 67, 71, 74, 78, 82, 85, 89, 92, 96, 100, 103},
+     {205, 130, -175, -45, 118, -98, -287, 407, -141, -11, -4, -162, -56, -75, 13, -380, -90, -309, 217, -264, 320, -426, -388, 11, -405, -359, 333, 146, 142, -26, 48, -239},
+     {2030, 2177, 2263, 2458, 2252, 2184, 2280, 2343, 2322, 2301, 2256, 2228, 2224, 2278, 2321, 2291}},
+    {CHORUS_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {CHORUS_MODE, SIGNAL_FULL_SCALE,
+     {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+     {-256, -1, 510, -1, -1, -512, -1, 510, -1, -512, -1, 510, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 510, -1, -512, -1, 510, -1, -1, -1, -1, 510},
+     {3238, 3707, 3455, 3185, 2890, 2565, 2197, 1751, 1197, 638, 1411, 1900, 2280, 2601, 2878, 3126}},
+    {FLANGER_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 255, 0, 0, 0, 0, 0, 0, 34, 220, 0, 0, 0, 0, 0, 2, 34, 115, 0, 0, 0, 0, 0, 3, 26},
+     {5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {230, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {FLANGER_MODE, SIGNAL_SWEEP,
+     {0, 2, 5, 8, 11, 14, 17, 20, 24, 29, 36, 42, 48, 54, 61, 67, 75, 83, 92, 100, 109, 117, 126, 135, 144, 154, 164, 174, 184, 195, 205, 215},
+     {461, -232, 304, 159, 195, 24, 25, 60, 93, 85, -79, -3, -102, 175, 221, -213, 265, -125, 351, -20, 332, -193, -164, 32, -81, -85, 41, -184, -14, -212, -263, -154},
+     {3461, 2802, 1752, 1077, 715, 670, 1037, 1895, 3280, 3545, 1991, 962, 689, 1222, 2700, 3438}},
+    {FLANGER_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {FLANGER_MODE, SIGNAL_FULL_SCALE,
+     {255, 255, 255, 255, 255, 255, 255, 293, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510},
+     {-512, -359, 510, 429, -1, -512, -1, 510, -1, -512, -359, 510, 356, -1, -447, -1, 510, -1, -512, -359, 510, 356, -1, -359, -1, 460, -1, -512, -56, 510, 356, -1},
+     {4204, 4091, 4053, 4019, 3975, 3942, 3899, 3848, 3797, 3698, 3642, 3590, 3567, 3512, 3458, 3418}},
+    {VIBRATO_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {304, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {VIBRATO_MODE, SIGNAL_SWEEP,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 48, -203, 445, -34, 319, -353, -123, -413, 98, 54, -372, -209, -327, 29, -433, -438, 265, -435, -426, -14, -236, 38, -420, 431, 303, 388, -305, -389, 271, -442, -357},
+     {2764, 3243, 3246, 3264, 3264, 3234, 3242, 3218, 3209, 3178, 3165, 3140, 3105, 3086, 3066, 3025}},
+    {VIBRATO_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {VIBRATO_MODE, SIGNAL_FULL_SCALE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {119, -512, 510, 510, -512, -512, 510, 510, -512, -512, 510, 510, -512, -512, 327, 510, 510, -512, -512, -512, 510, 510, 510, -512, -512, -512, 510, 510, 510, -512, -512, 510},
+     {4374, 5081, 5085, 5063, 5057, 5069, 5074, 5065, 5061, 5058, 5089, 5053, 5076, 5033, 5050, 5064}},
+    {TREMOLO_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 330, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {206, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {TREMOLO_MODE, SIGNAL_SWEEP,
+     {0, 3, 7, 11, 14, 18, 22, 26, 31, 34, 39, 43, 47, 51, 56, 60, 65, 69, 73, 78, 82, 87, 91, 96, 100, 105, 110, 114, 119, 124, 128, 132},
+     {258, 20, 52, -96, 202, -146, -118, 158, 53, 133, -130, -59, -128, 70, 83, -148, 6, -102, 77, -126, 147, -220, -205, -74, -250, -307, 279, -112, 284, -352, -241, -306},
+     {1895, 1731, 1435, 1237, 1086, 998, 992, 1055, 1189, 1390, 1627, 1907, 2202, 2484, 2745, 2968}},
+    {TREMOLO_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {TREMOLO_MODE, SIGNAL_FULL_SCALE,
+     {331, 331, 331, 331, 331, 331, 330, 330, 330, 330, 330, 330, 329, 329, 329, 329, 329, 328, 328, 328, 328, 328, 328, 327, 327, 327, 327, 327, 327, 326, 326, 326},
+     {-322, -299, 275, 254, 234, -217, -201, 185, 173, -165, -159, 154, 153, 155, -161, -169, 179, 192, -208, -226, 244, 264, 286, -310, -333, 354, 377, -400, -421, 438, 456, 471},
+     {3098, 2659, 2260, 1932, 1695, 1564, 1549, 1649, 1862, 2167, 2550, 2982, 3437, 3884, 4295, 4644}},
+    {CHAIN_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 149, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+     {-1, -1, -2, -2, -2, -2, -2, -2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, -1, -1, -1, -1, -1, -1, -1, -1},
+     {94, 94, 63, 43, 28, 18, 10, 14, 11, 10, 10, 10, 10, 10, 10, 10}},
+    {CHAIN_MODE, SIGNAL_SWEEP,
+     {0, 17, 37, 56, 72, 87, 99, 109, 118, 124, 130, 133, 136, 138, 139, 140, 140, 140, 140, 140, 140, 140, 139, 139, 138, 138, 137, 137, 136, 135, 135, 134},
+     {118, 92, 261, -354, -19, -251, 64, 433, 318, 179, -409, -73, -430, 511, 205, 16, 170, 47, 156, 183, 241, 9, -196, 29, -414, -10, 173, 28, 125, -350, -80, -32},
+     {1386, 1774, 2204, 2254, 2340, 2350, 2355, 2372, 2367, 2358, 2343, 2372, 2309, 2327, 2344, 2363}},
+    {CHAIN_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {CHAIN_MODE, SIGNAL_FULL_SCALE,
+     {149, 148, 147, 147, 146, 146, 145, 145, 144, 143, 143, 142, 142, 141, 141, 140, 140, 139, 138, 138, 137, 137, 136, 136, 135, 135, 134, 134, 133, 133, 132, 132},
+     {-152, -158, 274, 299, 9, -220, 77, 332, -153, -301, -114, 285, 129, -88, -152, 62, 295, -78, -295, -161, 294, 148, -92, -147, 83, 296, -84, -293, -155, 285, 149, -86},
+     {1486, 2323, 2584, 2491, 2154, 1879, 1787, 1883, 1974, 1980, 1981, 1952, 1942, 1931, 1940, 1971}},
+    {LOOPER_MODE, SIGNAL_IMPULSE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 510, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {319, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {LOOPER_MODE, SIGNAL_SWEEP,
+     {0, 4, 10, 16, 22, 28, 34, 40, 47, 53, 60, 66, 73, 79, 86, 93, 100, 107, 114, 121, 128, 135, 142, 149, 156, 164, 171, 178, 185, 193, 200, 207},
+     {411, 35, 97, -191, 440, -343, -301, 437, 157, 414, -420, -194, -425, 232, 264, -447, 19, -270, 191, -286, 307, -424, -365, -121, -385, -442, 378, -143, 345, -409, -269, -331},
+     {3137, 3323, 3244, 3270, 3274, 3259, 3273, 3265, 3263, 3276, 3259, 3267, 3272, 3266, 3263, 3265}},
+    {LOOPER_MODE, SIGNAL_SILENCE,
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},
+    {LOOPER_MODE, SIGNAL_FULL_SCALE,
+     {510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510},
+     {-512, -512, 510, 510, 510, -512, -512, 510, 510, -512, -512, 510, 510, 510, -512, -512, 510, 510, -512, -512, 510, 510, 510, -512, -512, 510, 510, -512, -512, 510, 510, 510},
+     {5109, 5111, 5109, 5110, 5110, 5110, 5111, 5109, 5111, 5109, 5111, 5109, 5110, 5110, 5110, 5111}},
+};
+
+#endif
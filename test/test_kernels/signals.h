@@ -0,0 +1,53 @@
+#ifndef SIGNALS_H
+#define SIGNALS_H
+#include <stdint.h>
+
+/* Deterministic test inputs as 10-bit ADC codes (512 is silence), integer only so
+ * tools/gen_golden.py produces the very same samples. Keep the two in step.*/
+#define SIGNAL_SAMPLES 4096
+#define SIGNAL_IMPULSE_AT 8
+#define SIGNAL_SWEEP_STEP 6845000UL  // Phase step at the start, ~50 Hz
+#define SIGNAL_SWEEP_RAMP 165000UL   // Added to the step every sample, ~5 kHz at the end
+#define SIGNAL_SWEEP_AMPLITUDE 448   // Codes
+#define SIGNAL_SQUARE_PERIOD 72      // Samples, ~436 Hz
+
+enum GoldenSignal {
+    SIGNAL_IMPULSE = 0, // One full-scale sample
+    SIGNAL_SWEEP,       // Parabolic-sine sweep, ~50 Hz to ~5 kHz
+    SIGNAL_SILENCE,     // Mid-scale throughout
+    SIGNAL_FULL_SCALE,  // Square wave between the ADC rails
+    NUM_SIGNALS
+};
+
+/*Sweep state: the phase step grows by SIGNAL_SWEEP_RAMP each sample*/
+struct SweepState {
+    uint32_t phase;
+    uint32_t step;
+};
+
+/**
+ * @brief: Sample n of signal, in order from n = 0 (the sweep keeps its state in sweep).
+ */
+static inline uint16_t signalCode(uint8_t signal, uint16_t n, SweepState &sweep) {
+    switch (signal) {
+    case SIGNAL_IMPULSE:
+        return n == SIGNAL_IMPULSE_AT ? 1023 : 512;
+    case SIGNAL_SWEEP: {
+        if (n == 0) {
+            sweep.phase = 0;
+            sweep.step = SIGNAL_SWEEP_STEP;
+        }
+        int32_t x = (int16_t)(sweep.phase >> 16);
+        int32_t y = x * (32768 - (x < 0 ? -x : x)); // Parabola through the sine's zeros, peak 2^28
+        sweep.phase += sweep.step;
+        sweep.step += SIGNAL_SWEEP_RAMP;
+        return (uint16_t)(512 + (int16_t)(((int64_t)y * SIGNAL_SWEEP_AMPLITUDE) >> 28));
+    }
+    case SIGNAL_FULL_SCALE:
+        return (n % SIGNAL_SQUARE_PERIOD) < SIGNAL_SQUARE_PERIOD / 2 ? 1023 : 0;
+    default:
+        return 512;
+    }
+}
+
+#endif
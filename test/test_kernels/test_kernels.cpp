@@ -0,0 +1,478 @@
+/* Golden-output regression tests for the effect kernels (pio test -e native).
+ * Every mode runs the signals of signals.h through the real TIMER1_CAPT_vect, fed
+ * through the SAMPLE_IO_BUFFER backend (sampleio.h), from the power-on state, and its 10-bit output is compared with golden.h:
+ * samples within GOLDEN_CODE_TOLERANCE codes, window RMS within GOLDEN_RMS_TOLERANCE.
+ * The tolerances let rounding change in a DSP optimisation; anything audible fails.
+ * golden.h is regenerated by tools/gen_golden.py.*/
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+#include "main.h"
+#include "effects.h"
+#include "effectchain.h"
+#include "outputgain.h"
+#include "transition.h"
+#include "sampleio.h"
+#include "adpcm.h"
+#include "golden.h"
+
+static_assert(F_CPU / AUDIO_SAMPLE_PERIOD_CYCLES == GOLDEN_SAMPLE_RATE_HZ,
+              "golden.h was made at another AUDIO_RATE; test at that rate or regenerate it (tools/gen_golden.py)");
+
+#define GOLDEN_CODE_TOLERANCE 2 // 10-bit codes
+#define GOLDEN_RMS_TOLERANCE 1  // Tenths of a code (windowRms()): 0.1 code
+
+#define LOOPER_TAKE_SAMPLES 1024 // Of the sweep, ~50 Hz to ~1.3 kHz
+#define LOOPER_MIN_SNR_DB 15.0   // Playback against the take; the decimation alone leaves ~20 dB on the sweep
+#define ADPCM_MIN_SNR_DB 20.0    // Codec round trip of the sweep at the sample rate (~25 dB: it reaches 5 kHz)
+
+#define SINE_TEST_SAMPLES 16384     // ~0.5 s: frequency from the first and last zero crossings
+#define SINE_MAX_ERROR_PPM 40.0     // Step rounding, SINE_STEP_PER_DECIHERTZ (sinewave.h): -15 ppm at 31.4 kHz
+#define SINE_MIN_SNR_DB 80.0        // Against the ideal sine at the step's frequency (~84.7 dB: table and Q15 rounding)
+
+#define REVERB_DECAY_SAMPLES 65536UL // Impulse response length (~2 s), past the float tail's RT60
+#define REVERB_RT60_TOLERANCE 0.20   // Of the float network's RT60 (fixed point: ~1.11 s against ~1.22 s)
+
+extern void setup(void);
+extern "C" void TIMER1_CAPT_vect(void);
+
+static int16_t output[SIGNAL_SAMPLES]; // Centered 10-bit codes
+
+static const char *const signalNames[NUM_SIGNALS] = {"impulse", "sweep", "silence", "full scale"};
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Puts every effect back in its power-on state and selects mode without a fade.
+ */
+static void resetPedal(EffectMode mode) {
+    memset(&effectArena, 0, sizeof(effectArena));
+    ActiveEffects::paramsSetupAll(effectParamBanks);
+    effectChainSetup();
+    outputGainSetVolume(1024, true);
+    transitionSetup(mode);
+}
+
+static void render(EffectMode mode, uint8_t signal) {
+    static q15_t samples[SIGNAL_SAMPLES];
+    SweepState sweep = {0, 0};
+    for (uint16_t n = 0; n < SIGNAL_SAMPLES; n++) {
+        samples[n] = q15From10Bit(signalCode(signal, n, sweep));
+    }
+    resetPedal(mode);
+    sampleIoBufferBind(samples, samples);
+    for (uint16_t n = 0; n < SIGNAL_SAMPLES; n++) {
+        TIMER1_CAPT_vect();
+        output[n] = (int16_t)q15To10Bit(samples[n]) - 512;
+    }
+}
+
+static uint16_t windowRms(uint16_t window) {
+    double sum = 0.0;
+    for (uint16_t n = window * GOLDEN_WINDOW; n < (window + 1) * GOLDEN_WINDOW; n++) {
+        sum += (double)output[n] * output[n];
+    }
+    return (uint16_t)lround(10.0 * sqrt(sum / GOLDEN_WINDOW));
+}
+
+/**
+ * @brief: Compares the output of every signal in mode with its golden summary.
+ */
+static void checkMode(EffectMode mode) {
+    char message[64];
+    uint8_t cases = 0;
+    for (size_t c = 0; c < sizeof(goldenCases) / sizeof(goldenCases[0]); c++) {
+        const GoldenCase &golden = goldenCases[c];
+        if (golden.mode != mode) continue;
+        cases++;
+        render(mode, golden.signal);
+        for (uint16_t i = 0; i < GOLDEN_HEAD; i++) {
+            snprintf(message, sizeof(message), "%s, sample %u", signalNames[golden.signal], i);
+            TEST_ASSERT_INT_WITHIN_MESSAGE(GOLDEN_CODE_TOLERANCE, golden.head[i], output[i], message);
+        }
+        for (uint16_t i = 0; i < GOLDEN_POINTS; i++) {
+            uint16_t n = GOLDEN_STRIDE / 2 + i * GOLDEN_STRIDE;
+            snprintf(message, sizeof(message), "%s, sample %u", signalNames[golden.signal], n);
+            TEST_ASSERT_INT_WITHIN_MESSAGE(GOLDEN_CODE_TOLERANCE, golden.points[i], output[n], message);
+        }
+        for (uint16_t w = 0; w < GOLDEN_WINDOWS; w++) {
+            snprintf(message, sizeof(message), "%s, RMS of window %u", signalNames[golden.signal], w);
+            TEST_ASSERT_INT_WITHIN_MESSAGE(GOLDEN_RMS_TOLERANCE, golden.rms[w], windowRms(w), message);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(NUM_SIGNALS, cases, "golden.h is missing signals for this mode");
+}
+
+void test_clean(void) { checkMode(CLEAN_MODE); }
+void test_normal(void) { checkMode(NORMAL_MODE); }
+void test_reverb(void) { checkMode(REVERB_ECHO_MODE); }
+void test_delay(void) { checkMode(DELAY_MODE); }
+void test_echo(void) { checkMode(ECHO_MODE); }
+void test_octaver(void) { checkMode(OCTAVER_MODE); }
+void test_distortion(void) { checkMode(DISTORTION_MODE); }
+void test_sinewave(void) { checkMode(SINEWAVE_MODE); }
+void test_chorus(void) { checkMode(CHORUS_MODE); }
+void test_flanger(void) { checkMode(FLANGER_MODE); }
+void test_vibrato(void) { checkMode(VIBRATO_MODE); }
+void test_tremolo(void) { checkMode(TREMOLO_MODE); }
+void test_chain(void) { checkMode(CHAIN_MODE); }
+void test_looper(void) { checkMode(LOOPER_MODE); }
+
+/**
+ * @brief: Records a take of the sweep, closes the loop and checks that it plays back over
+ * silence, repeating at the loop length. Playback trails the take by up to two stored
+ * samples (looper.h); the best lag in that range is compared.
+ */
+void test_looper_plays_back(void) {
+    static q15_t samples[SIGNAL_SAMPLES];
+    SweepState sweep = {0, 0};
+    for (uint16_t n = 0; n < SIGNAL_SAMPLES; n++) {
+        uint16_t code = signalCode(SIGNAL_SWEEP, n, sweep);
+        samples[n] = (n < LOOPER_TAKE_SAMPLES) ? q15From10Bit(code) : 0;
+    }
+    static q15_t take[LOOPER_TAKE_SAMPLES];
+    memcpy(take, samples, sizeof(take));
+
+    resetPedal(LOOPER_MODE);
+    sampleIoBufferBind(samples, samples);
+    for (uint16_t n = 0; n < SIGNAL_SAMPLES; n++) {
+        TIMER1_CAPT_vect();
+        if (n == LOOPER_TAKE_SAMPLES - 1) looperPress(); // Closes the take at the next stored sample
+    }
+    const uint16_t loopSamples = LOOPER_TAKE_SAMPLES + LOOPER_DECIMATION;
+
+    double best = 0.0;
+    for (uint8_t lag = 0; lag <= 2 * LOOPER_DECIMATION; lag++) {
+        double signal = 0.0, error = 0.0;
+        for (uint16_t n = 2 * LOOPER_DECIMATION; n < LOOPER_TAKE_SAMPLES; n++) {
+            for (uint16_t pass = 1; pass <= 2; pass++) {
+                double played = samples[pass * loopSamples + n + lag];
+                signal += (double)take[n] * take[n];
+                error += (played - take[n]) * (played - take[n]);
+            }
+        }
+        double snr = 10.0 * log10(signal / error);
+        if (snr > best) best = snr;
+    }
+    char message[48];
+    snprintf(message, sizeof(message), "playback SNR %.1f dB", best);
+    TEST_ASSERT_TRUE_MESSAGE(best >= LOOPER_MIN_SNR_DB, message);
+}
+
+/**
+ * @brief: A press right after the first take starts, shorter than LOOPER_MIN_SLOTS, does
+ * not close a loop of a few slots: it is dropped and the take goes on recording.
+ */
+void test_looper_press_on_first_sample(void) {
+    static q15_t samples[LOOPER_DECIMATION];
+    memset(samples, 0, sizeof(samples));
+    resetPedal(LOOPER_MODE);
+    sampleIoBufferBind(samples, samples);
+    TIMER1_CAPT_vect(); // Runs restartLooper()
+    looperPress();
+    for (uint8_t n = 1; n < LOOPER_DECIMATION; n++) {
+        TIMER1_CAPT_vect();
+    }
+    const Looper &looper = effectState<EchoEffect>().looper;
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(LOOPER_REQUEST_NONE, effectState<EchoEffect>().looperRequest, "press still pending");
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(LOOPER_RECORDING, looper.phase, "take closed");
+    TEST_ASSERT_EQUAL_UINT16(0, looper.length);
+}
+
+/**
+ * @brief: The codec alone, on the whole sweep: round-trip SNR, and re-encoding the decoded
+ * stream from the same state gives back the same codes (what the looper relies on when it
+ * rewrites every slot on every pass).
+ */
+void test_adpcm_round_trip(void) {
+    AdpcmState encoder, decoder, reencoder;
+    adpcmReset(encoder);
+    adpcmReset(decoder);
+    adpcmReset(reencoder);
+    SweepState sweep = {0, 0};
+    double signal = 0.0, error = 0.0;
+    for (uint16_t n = 0; n < SIGNAL_SAMPLES; n++) {
+        q15_t sample = q15From10Bit(signalCode(SIGNAL_SWEEP, n, sweep));
+        uint8_t code = adpcmEncode(encoder, sample);
+        q15_t decoded = adpcmDecode(decoder, code);
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(code, adpcmEncode(reencoder, decoded), "re-encoding changed a code");
+        signal += (double)sample * sample;
+        error += ((double)decoded - sample) * ((double)decoded - sample);
+    }
+    double snr = 10.0 * log10(signal / error);
+    char message[48];
+    snprintf(message, sizeof(message), "round-trip SNR %.1f dB", snr);
+    TEST_ASSERT_TRUE_MESSAGE(snr >= ADPCM_MIN_SNR_DB, message);
+}
+
+/**
+ * @brief: One DDS voice at several frequencies across the guitar range and above: the
+ * output frequency matches the requested one within the step rounding, and what is left
+ * after removing the ideal sine (table interpolation and Q15 rounding) stays below
+ * SINE_MIN_SNR_DB.
+ */
+void test_sinewave_frequency(void) {
+    static const uint16_t frequencies[] = {824, 4400, 10000, 50000}; // 0.1 Hz: low E, A4, 1 kHz, 5 kHz
+    static double tone[SINE_TEST_SAMPLES];
+    char message[64];
+    for (uint8_t f = 0; f < sizeof(frequencies) / sizeof(frequencies[0]); f++) {
+        resetPedal(SINEWAVE_MODE);
+        sinewaveSetVoice(0, frequencies[f], Q15_MAX);
+        for (uint16_t n = 0; n < SINE_TEST_SAMPLES; n++) {
+            tone[n] = processSinewaveAudio(0) / 32768.0;
+        }
+
+        // Rising zero crossings, interpolated between samples
+        double first = -1.0, last = 0.0;
+        uint16_t cycles = 0;
+        for (uint16_t n = 1; n < SINE_TEST_SAMPLES; n++) {
+            if (tone[n - 1] < 0.0 && tone[n] >= 0.0) {
+                double crossing = n - 1 + tone[n - 1] / (tone[n - 1] - tone[n]);
+                if (first < 0.0) first = crossing;
+                else cycles++;
+                last = crossing;
+            }
+        }
+        double requested = frequencies[f] / 10.0;
+        double measured = cycles * AUDIO_SAMPLE_RATE_HZ / (last - first);
+        double errorPpm = 1e6 * (measured - requested) / requested;
+        snprintf(message, sizeof(message), "%.1f Hz: measured %.4f Hz (%.1f ppm)", requested, measured, errorPpm);
+        TEST_ASSERT_TRUE_MESSAGE(fabs(errorPpm) <= SINE_MAX_ERROR_PPM, message);
+
+        // Least-squares fit of the ideal sine at the frequency the phase step stands for (the
+        // crossings only resolve it to ~1 ppm, too coarse to follow 5 kHz over 0.5 s); the rest is noise
+        double omega = 2.0 * M_PI * effectParams<SinewaveEffect>().live().step[0] / 4294967296.0;
+        double ss = 0.0, cc = 0.0, sc = 0.0, ts = 0.0, tc = 0.0;
+        for (uint16_t n = 0; n < SINE_TEST_SAMPLES; n++) {
+            double s = sin(omega * n), c = cos(omega * n);
+            ss += s * s; cc += c * c; sc += s * c;
+            ts += tone[n] * s; tc += tone[n] * c;
+        }
+        double determinant = ss * cc - sc * sc;
+        double sine = (ts * cc - tc * sc) / determinant, cosine = (tc * ss - ts * sc) / determinant;
+        double signal = 0.0, noise = 0.0;
+        for (uint16_t n = 0; n < SINE_TEST_SAMPLES; n++) {
+            double ideal = sine * sin(omega * n) + cosine * cos(omega * n);
+            signal += ideal * ideal;
+            noise += (tone[n] - ideal) * (tone[n] - ideal);
+        }
+        double snr = 10.0 * log10(signal / noise);
+        snprintf(message, sizeof(message), "%.1f Hz: SNR %.1f dB", requested, snr);
+        TEST_ASSERT_TRUE_MESSAGE(snr >= SINE_MIN_SNR_DB, message);
+    }
+}
+
+/**
+ * @brief: RT60 of an impulse response from its Schroeder decay curve, extrapolated from
+ * the -5 to -25 dB range (T20): below that a full-scale impulse's tail is within a few
+ * steps of the 10-bit lines, where no fixed-point network can follow the float one.
+ */
+static double reverbRt60(const double *response) {
+    static double decay[REVERB_DECAY_SAMPLES];
+    double energy = 0.0;
+    for (int32_t n = REVERB_DECAY_SAMPLES - 1; n >= 0; n--) {
+        energy += response[n] * response[n];
+        decay[n] = energy;
+    }
+    int32_t start = -1;
+    for (uint32_t n = 0; n < REVERB_DECAY_SAMPLES; n++) {
+        double level = 10.0 * log10(decay[n] / decay[0]);
+        if (start < 0 && level <= -5.0) start = n;
+        if (level <= -25.0) return 3.0 * (n - start) / AUDIO_SAMPLE_RATE_HZ;
+    }
+    return 0.0; // Never reached -25 dB
+}
+
+/**
+ * @brief: REVERB_ECHO_MODE's impulse response decays like the same network in double
+ * precision (decimation, combs, damping and all-passes as in reverb.cpp), at the default
+ * settings. The impulse lasts one block, so the network sees a full-scale input.
+ */
+void test_reverb_decay(void) {
+    static const uint8_t combLengths[REVERB_COMBS] = {61, 59, 53};
+    static const uint8_t allpassLengths[REVERB_ALLPASSES] = {13, 11};
+    static double fixedResponse[REVERB_DECAY_SAMPLES], floatResponse[REVERB_DECAY_SAMPLES];
+    static double combLines[REVERB_COMBS][REVERB_DECAY_SAMPLES / REVERB_DECIMATION];
+    static double allpassLines[REVERB_ALLPASSES][REVERB_DECAY_SAMPLES / REVERB_DECIMATION];
+    double damped[REVERB_COMBS] = {0};
+    double inputSum = 0.0, blockInput = 0.0, combSum = 0.0, wet = 0.0, ramp = 0.0, rampStep = 0.0;
+
+    resetPedal(REVERB_ECHO_MODE);
+    const ReverbParams &params = effectParams<ReverbEffect>().live();
+    const double roomSize = params.roomSize / 32768.0, damping = params.damping / 32768.0, mix = params.mix / 32768.0;
+    for (uint32_t n = 0; n < REVERB_DECAY_SAMPLES; n++) {
+        q15_t input = (n < REVERB_DECIMATION) ? Q15_MAX : 0;
+        fixedResponse[n] = processReverbAudio(input, REVERB_ECHO_MODE) / 32768.0;
+
+        double dry = input / 32768.0;
+        uint32_t block = n / REVERB_DECIMATION;
+        uint8_t slot = n % REVERB_DECIMATION;
+        inputSum += dry / REVERB_DECIMATION;
+        if (slot < REVERB_COMBS) {
+            double combOutput = (block >= combLengths[slot]) ? combLines[slot][block - combLengths[slot]] : 0.0;
+            damped[slot] = combOutput + (damped[slot] - combOutput) * damping;
+            combLines[slot][block] = blockInput + damped[slot] * roomSize;
+            combSum += combOutput;
+        } else if (slot < REVERB_COMBS + REVERB_ALLPASSES) {
+            uint8_t i = slot - REVERB_COMBS;
+            if (i == 0) {
+                wet = combSum;
+                combSum = 0.0;
+            }
+            double lineOutput = (block >= allpassLengths[i]) ? allpassLines[i][block - allpassLengths[i]] : 0.0;
+            allpassLines[i][block] = wet + 0.5 * lineOutput;
+            wet = lineOutput - wet;
+        }
+        double output = ramp;
+        ramp += rampStep;
+        if (slot == REVERB_DECIMATION - 1) {
+            blockInput = 0.5 * inputSum;
+            inputSum = 0.0;
+            rampStep = (wet * 2.0 / REVERB_COMBS - ramp) / REVERB_DECIMATION;
+        }
+        floatResponse[n] = dry + (output - dry) * mix;
+    }
+    for (uint8_t n = 0; n < REVERB_DECIMATION; n++) {
+        fixedResponse[n] = floatResponse[n] = 0.0; // The dry impulse is not part of the tail
+    }
+
+    double fixedRt60 = reverbRt60(fixedResponse), floatRt60 = reverbRt60(floatResponse);
+    char message[64];
+    snprintf(message, sizeof(message), "RT60 %.3f s, float %.3f s", fixedRt60, floatRt60);
+    TEST_ASSERT_TRUE_MESSAGE(fabs(fixedRt60 - floatRt60) <= REVERB_RT60_TOLERANCE * floatRt60, message);
+}
+
+/**
+ * @brief: A chain may not run two modes of one effect, nor one mode twice: they would share
+ * its State. The rejected chain leaves the running one in place.
+ */
+void test_chain_rejects_shared_effects(void) {
+    static const EffectMode shared[][2] = {
+        {ECHO_MODE, LOOPER_MODE},
+        {REVERB_ECHO_MODE, DELAY_MODE},
+        {CHORUS_MODE, FLANGER_MODE},
+        {ECHO_MODE, ECHO_MODE},
+    };
+    effectChainSetup();
+    for (uint8_t i = 0; i < sizeof(shared) / sizeof(shared[0]); i++) {
+        TEST_ASSERT_FALSE_MESSAGE(effectChainSelect(shared[i], 2), "chain sharing an effect accepted");
+    }
+    const EffectMode defaults[] = EFFECT_CHAIN_DEFAULT;
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(sizeof(defaults) / sizeof(defaults[0]), effectChainLength, "running chain changed");
+    const EffectMode distinct[] = {DISTORTION_MODE, CHORUS_MODE};
+    TEST_ASSERT_TRUE_MESSAGE(effectChainSelect(distinct, 2), "chain of distinct effects rejected");
+    effectChainSetup();
+}
+
+void test_chain_reports_each_rejection(void) {
+    const EffectMode two[] = {DISTORTION_MODE, CHORUS_MODE};
+    const EffectMode unknown[] = {DISTORTION_MODE, CHAIN_MODE};
+    const EffectMode shared[] = {ECHO_MODE, LOOPER_MODE};
+    const EffectMode heavy[] = {REVERB_ECHO_MODE, ECHO_MODE, CHORUS_MODE, OCTAVER_MODE};
+    TEST_ASSERT_EQUAL_INT(EFFECT_CHAIN_OK, effectChainCheck(two, 2));
+    TEST_ASSERT_EQUAL_INT(EFFECT_CHAIN_BAD_LENGTH, effectChainCheck(two, 1));
+    TEST_ASSERT_EQUAL_INT(EFFECT_CHAIN_BAD_STAGE, effectChainCheck(unknown, 2));
+    TEST_ASSERT_EQUAL_INT(EFFECT_CHAIN_SHARED, effectChainCheck(shared, 2));
+    TEST_ASSERT_EQUAL_INT(EFFECT_CHAIN_OVER_BUDGET, effectChainCheck(heavy, 4));
+}
+
+/**
+ * @brief: Runs count samples of silence through the ISR.
+ * @return The largest output, in 10-bit codes from the center.
+ */
+static int16_t runSilence(uint16_t count) {
+    static q15_t samples[SIGNAL_SAMPLES];
+    int16_t peak = 0;
+    while (count) {
+        uint16_t block = (count < SIGNAL_SAMPLES) ? count : SIGNAL_SAMPLES;
+        memset(samples, 0, sizeof(samples));
+        sampleIoBufferBind(samples, samples);
+        for (uint16_t n = 0; n < block; n++) {
+            TIMER1_CAPT_vect();
+            int16_t code = abs((int16_t)q15To10Bit(samples[n]) - 512);
+            if (code > peak) peak = code;
+        }
+        count -= block;
+    }
+    return peak;
+}
+
+/**
+ * @brief: Switches to mode and runs silence until the transition is over.
+ */
+static void switchMode(EffectMode mode) {
+    transitionTo(mode);
+    while (transition.phase != TRANSITION_IDLE) {
+        runSilence(1);
+    }
+}
+
+/**
+ * @brief: Echoes an impulse, leaves ECHO_MODE for via and comes back.
+ * @return The largest output over the next few repeats.
+ */
+static int16_t echoAfterVisit(EffectMode via) {
+    static q15_t impulse[1] = {Q15_MAX / 2};
+    resetPedal(ECHO_MODE);
+    sampleIoBufferBind(impulse, impulse);
+    TIMER1_CAPT_vect();
+    switchMode(via);
+    switchMode(ECHO_MODE);
+    return runSilence(2 * (1 << ECHO_DELAY_SIZE_LOG2));
+}
+
+/**
+ * @brief: Switching back to an effect resumes its tail when the mode in between had its own
+ * State, and starts it from silence when that mode shared it (LOOPER_MODE takes the echo
+ * line's bytes).
+ */
+void test_switch_back_keeps_lines(void) {
+    TEST_ASSERT_TRUE_MESSAGE(echoAfterVisit(NORMAL_MODE) > GOLDEN_CODE_TOLERANCE, "echo tail cleared");
+    TEST_ASSERT_EQUAL_INT16_MESSAGE(0, echoAfterVisit(LOOPER_MODE), "stale line after a shared effect");
+}
+
+/**
+ * @brief: Silence in must give silence out in every mode but the generator.
+ */
+void test_silence_stays_silent(void) {
+    for (uint8_t mode = 0; mode < NUM_EFFECTS_ENUM; mode++) {
+        if (mode == SINEWAVE_MODE) continue;
+        render((EffectMode)mode, SIGNAL_SILENCE);
+        for (uint16_t n = 0; n < SIGNAL_SAMPLES; n++) {
+            TEST_ASSERT_EQUAL_INT16_MESSAGE(0, output[n], "output without input");
+        }
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    (void)argc; (void)argv;
+    setup(); // Pins, ADC, Timer1 and effect setup against the shim
+    UNITY_BEGIN();
+    RUN_TEST(test_clean);
+    RUN_TEST(test_normal);
+    RUN_TEST(test_reverb);
+    RUN_TEST(test_delay);
+    RUN_TEST(test_echo);
+    RUN_TEST(test_octaver);
+    RUN_TEST(test_distortion);
+    RUN_TEST(test_sinewave);
+    RUN_TEST(test_chorus);
+    RUN_TEST(test_flanger);
+    RUN_TEST(test_vibrato);
+    RUN_TEST(test_tremolo);
+    RUN_TEST(test_chain);
+    RUN_TEST(test_looper);
+    RUN_TEST(test_looper_plays_back);
+    RUN_TEST(test_looper_press_on_first_sample);
+    RUN_TEST(test_adpcm_round_trip);
+    RUN_TEST(test_sinewave_frequency);
+    RUN_TEST(test_reverb_decay);
+    RUN_TEST(test_chain_rejects_shared_effects);
+    RUN_TEST(test_chain_reports_each_rejection);
+    RUN_TEST(test_switch_back_keeps_lines);
+    RUN_TEST(test_silence_stays_silent);
+    return UNITY_END();
+}
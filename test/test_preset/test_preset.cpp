@@ -0,0 +1,162 @@
+/* Preset store (preset.h) against the host EEPROM (pio test -e native).
+ * The shim's EEPROM is an array that counts the writes to every cell (hostEepromWrites),
+ * and hostAdvanceMillis() stands in for the seconds a save waits to settle. A reboot is
+ * the parameter defaults, the boot mode and presetSetup() again, as in setup().*/
+#include <Arduino.h>
+#include <avr/eeprom.h>
+#include <string.h>
+#include <unity.h>
+#include "main.h"
+#include "effects.h"
+#include "preset.h"
+
+/*Record layout of preset.cpp*/
+#define PRESET_HEADER_BYTES 8
+#define PRESET_RECORD_BYTES (PRESET_HEADER_BYTES + 2 * ActiveEffects::totalParamCount + 2)
+#define PRESET_RING_START (PRESET_USER_SLOTS * PRESET_RECORD_BYTES)
+#define PRESET_RING_SLOTS ((E2END + 1 - PRESET_RING_START) / PRESET_RECORD_BYTES)
+
+#define WEAR_SAVES (4 * PRESET_RING_SLOTS) // Four times round the ring
+
+extern void setup(void);
+
+static uint8_t testEffect; // Parameter the tests change: the first one of the first effect that has any
+static ParamInfo testParam;
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+static uint16_t testParamGet(void) {
+    uint16_t value = 0;
+    ActiveEffects::paramGet(effectParamBanks, testEffect, 0, value);
+    return value;
+}
+
+static void testParamSet(uint16_t value) {
+    TEST_ASSERT_EQUAL_UINT8(PARAM_OK, ActiveEffects::paramSet(effectParamBanks, testEffect, 0, value));
+}
+
+/*An end of the parameter's range other than its default, and the other end*/
+static uint16_t testValue(void) { return (testParam.def == testParam.max) ? testParam.min : testParam.max; }
+static uint16_t otherValue(void) { return (testParam.def == testParam.max) ? testParam.max : testParam.min; }
+
+/**
+ * @brief: Power cycle: defaults, boot mode, then the restore.
+ * @return What presetSetup() returns: true if a ring record was restored.
+ */
+static bool reboot(void) {
+    ActiveEffects::paramsSetupAll(effectParamBanks);
+    lastSelectedMode = NORMAL_MODE;
+    setMasterVolume(1024);
+    return presetSetup();
+}
+
+/**
+ * @brief: Runs presetService() until the record being written is complete (one byte per
+ * call; the host EEPROM is always ready).
+ */
+static void finishWrite(void) {
+    for (uint16_t i = 0; i < PRESET_RECORD_BYTES; i++) {
+        presetService();
+    }
+}
+
+/**
+ * @brief: Lets the last-used state settle and be saved to the ring, as loop() would.
+ */
+static void saveLastUsed(void) {
+    hostAdvanceMillis(PRESET_CHECK_MS);
+    presetService(); // Sees the change
+    hostAdvanceMillis(PRESET_SETTLE_MS);
+    presetService(); // Settled: starts the write
+    finishWrite();
+}
+
+void test_restore_after_reboot(void) {
+    testParamSet(testValue());
+    setMasterVolume(700);
+    TEST_ASSERT_TRUE(selectEffectMode(ECHO_MODE));
+    saveLastUsed();
+
+    TEST_ASSERT_TRUE_MESSAGE(reboot(), "nothing restored");
+    TEST_ASSERT_EQUAL_UINT16(testValue(), testParamGet());
+    TEST_ASSERT_EQUAL_INT(700, pot2_value);
+    TEST_ASSERT_EQUAL_INT(ECHO_MODE, lastSelectedMode);
+}
+
+void test_corrupt_record_falls_back(void) {
+    testParamSet(testValue());
+    saveLastUsed(); // Ring slot 0
+    testParamSet(otherValue());
+    saveLastUsed(); // Ring slot 1, the newest
+
+    hostEeprom[PRESET_RING_START + PRESET_RECORD_BYTES + PRESET_HEADER_BYTES] ^= 0x01; // As a cut-short write would
+    TEST_ASSERT_TRUE_MESSAGE(reboot(), "older record not restored");
+    TEST_ASSERT_EQUAL_UINT16(testValue(), testParamGet());
+
+    hostEeprom[PRESET_RING_START + PRESET_HEADER_BYTES] ^= 0x01;
+    TEST_ASSERT_FALSE_MESSAGE(reboot(), "restored a damaged record");
+    TEST_ASSERT_EQUAL_UINT16(testParam.def, testParamGet());
+}
+
+void test_wear_spreads_over_ring(void) {
+    for (uint16_t save = 0; save < WEAR_SAVES; save++) {
+        testParamSet((save & 1) ? otherValue() : testValue());
+        saveLastUsed();
+    }
+    for (uint16_t address = 0; address <= E2END; address++) {
+        if (address < PRESET_RING_START) {
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, hostEepromWrites[address], "ring save wrote a user preset");
+        } else {
+            // Every save rewrites one slot: no cell is written more often than its slot comes round
+            TEST_ASSERT_TRUE_MESSAGE(hostEepromWrites[address] <= WEAR_SAVES / PRESET_RING_SLOTS, "uneven wear");
+        }
+    }
+    for (uint8_t slot = 0; slot < PRESET_RING_SLOTS; slot++) {
+        uint16_t sequence = PRESET_RING_START + slot * PRESET_RECORD_BYTES + 1;
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(WEAR_SAVES / PRESET_RING_SLOTS, hostEepromWrites[sequence], "slot skipped");
+    }
+}
+
+void test_save_rejected_while_writing(void) {
+    testParamSet(testValue());
+    TEST_ASSERT_EQUAL_UINT8(PARAM_OK, presetSave(1));
+    presetService(); // One byte written
+    TEST_ASSERT_EQUAL_UINT8(PARAM_BUSY, presetSave(2));
+    TEST_ASSERT_EQUAL_UINT8(PARAM_BUSY, presetLoad(1));
+    finishWrite();
+
+    TEST_ASSERT_EQUAL_UINT8(PARAM_OK, presetSave(2));
+    finishWrite();
+    testParamSet(otherValue());
+    TEST_ASSERT_EQUAL_UINT8(PARAM_OK, presetLoad(1));
+    TEST_ASSERT_EQUAL_UINT16(testValue(), testParamGet());
+}
+
+/**
+ * @brief: Every test starts from an erased EEPROM and a fresh boot.
+ */
+void setUp(void) {
+    memset(hostEeprom, 0xFF, sizeof(hostEeprom));
+    memset(hostEepromWrites, 0, sizeof(hostEepromWrites));
+    reboot();
+}
+
+void tearDown(void) {
+    finishWrite(); // Leave no write in progress for the next test
+}
+
+int main(int argc, char **argv) {
+    (void)argc; (void)argv;
+    setup();
+    const ParamInfo *table = nullptr;
+    for (testEffect = 0; testEffect < ActiveEffects::effectCount; testEffect++) {
+        if (ActiveEffects::params(testEffect, table)) break;
+    }
+    paramInfoRead(table, 0, testParam);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_restore_after_reboot);
+    RUN_TEST(test_corrupt_record_falls_back);
+    RUN_TEST(test_wear_spreads_over_ring);
+    RUN_TEST(test_save_rejected_while_writing);
+    return UNITY_END();
+}
@@ -0,0 +1,370 @@
+#!/usr/bin/env python3
+"""Cycle benchmark of the uno firmware under simavr (see include/benchmark.h).
+
+Builds the bench image (the uno image with BENCHMARK set) and the tools/simbench.c
+harness, runs the image on a simulated ATmega328P with a scripted ADC input, and writes
+the exact cycle counts of TIMER1_CAPT_vect per mode, with flash and SRAM use, as JSON:
+
+    python3 tools/benchmark.py -o benchmark.json
+    python3 tools/benchmark.py -o after.json --compare benchmark.json
+    python3 tools/benchmark.py --input guitar.raw --elf .pio/build/bench/firmware.elf
+
+The default input is a decaying 82-1320 Hz sweep with some noise; --input takes a
+raw file of 10-bit codes (little-endian uint16, as the native build reads). Every
+mode compiled in runs for BENCHMARK_MODE_MS; ISRs of the first BENCHMARK_SETTLE_MS are
+left out while the delay lines fill, ISRs during the crossfades are reported under
+"transition". Each mode lists count, min, max, mean and percentiles of the ISR cycles,
+how many ISRs went over the sample period, and the headroom left at the worst case.
+The report also counts the push, pop and call instructions of TIMER1_CAPT_vect in the
+avr-objdump disassembly: what the flattened registry dispatch (effects.h) is meant to keep
+low. --compare prints the change in max and p99 per mode, in flash and in those counts
+against an earlier run, and exits 1 if a mode's max grew by more than --tolerance cycles.
+
+The chain and transition budgets trust the declared cycles of each mode, ISR_FIXED_CYCLES
+plus the effect's worstCaseCycles, which the image prints at boot (benchmarkSetup()). Each
+mode's report carries them as "declared", and the run prints them against the measured
+max with the constants that would cover it: ISR_FIXED_CYCLES from CLEAN_MODE, which runs
+no kernel, and each mode's kernel as its max less that. It exits 1 if any measured max is
+above its declared cycles, so an underestimate cannot go unnoticed. --apply then writes
+those constants into the headers: ISR_FIXED_CYCLES in include/effectchain.h and, in the
+header of each effect, worstCaseCycles from the largest kernel among the modes it handles().
+Review the diff and rebuild; a mode the run did not measure leaves its effect as it was.
+
+Needs PlatformIO, avr-size and avr-objdump (from the toolchain PlatformIO installs) and libsimavr
+with its headers (e.g. the simavr and libelf-dev packages).
+"""
+import argparse
+import json
+import math
+import os
+import random
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+F_CPU = 16000000
+SAMPLE_PERIOD_CYCLES = 510  # AUDIO_RATE_31K; the firmware's boot message overrides it
+SAMPLE_RATE = F_CPU / SAMPLE_PERIOD_CYCLES
+FLASH_BYTES = 32256  # 32 KB less the Optiboot bootloader
+SRAM_BYTES = 2048
+TAG_TRANSITION = 0xFE
+ISR_SYMBOL = "__vector_10"  # TIMER1_CAPT_vect
+PERCENTILES = [50, 90, 99, 99.9]
+
+
+def mode_names():
+    """EffectMode names in enum order, from include/main.h."""
+    with open(os.path.join(ROOT, "include", "main.h")) as header:
+        text = header.read()
+    body = re.search(r"enum EffectMode\s*{(.*?)}", text, re.S).group(1)
+    names = [re.match(r"\s*(\w+)", line).group(1) for line in body.splitlines() if re.match(r"\s*\w+", line)]
+    return [name for name in names if name != "NUM_EFFECTS_ENUM"]
+
+
+def default_input(path, seconds=4.0):
+    """Plucked-string-like sweep: notes from E2 up, each decaying, plus a little noise."""
+    rng = random.Random(1)
+    codes = []
+    note_samples = int(SAMPLE_RATE * 0.25)
+    frequency = 82.4
+    phase = 0.0
+    for i in range(int(SAMPLE_RATE * seconds)):
+        if i % note_samples == 0:
+            frequency = frequency * 2 ** (5 / 12.0) if frequency < 1320 else 82.4
+        envelope = math.exp(-4.0 * (i % note_samples) / note_samples)
+        phase += 2 * math.pi * frequency / SAMPLE_RATE
+        value = 0.9 * envelope * math.sin(phase) + rng.gauss(0, 0.01)
+        codes.append(max(0, min(1023, int(round(512 + 511 * value)))))
+    with open(path, "wb") as out:
+        out.write(struct.pack("<%dH" % len(codes), *codes))
+
+
+def build_firmware():
+    subprocess.check_call(["pio", "run", "-e", "bench"], cwd=ROOT)
+    return os.path.join(ROOT, ".pio", "build", "bench", "firmware.elf")
+
+
+def build_harness(workdir):
+    harness = os.path.join(workdir, "simbench")
+    cc = os.environ.get("CC", "cc")
+    subprocess.check_call([cc, "-O2", "-o", harness, os.path.join(ROOT, "tools", "simbench.c"), "-lsimavr", "-lelf"])
+    return harness
+
+
+def find_avr_tool(name):
+    found = shutil.which(name)
+    if found:
+        return found
+    packaged = os.path.expanduser("~/.platformio/packages/toolchain-atmelavr/bin/" + name)
+    if os.path.exists(packaged):
+        return packaged
+    raise SystemExit("%s not found; install the atmelavr platform or put it on PATH" % name)
+
+
+def memory_usage(elf):
+    """Flash (.text + .data) and static SRAM (.data + .bss) from avr-size -A."""
+    output = subprocess.check_output([find_avr_tool("avr-size"), "-A", elf]).decode()
+    sections = {}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0].startswith(".") and fields[1].isdigit():
+            sections[fields[0]] = int(fields[1])
+    flash = sections.get(".text", 0) + sections.get(".data", 0)
+    sram = sections.get(".data", 0) + sections.get(".bss", 0)
+    return {
+        "flash_bytes": flash,
+        "flash_percent": round(100.0 * flash / FLASH_BYTES, 1),
+        "sram_static_bytes": sram,
+        "sram_percent": round(100.0 * sram / SRAM_BYTES, 1),
+        "sram_free_for_stack": SRAM_BYTES - sram,
+    }
+
+
+def isr_code(elf):
+    """Instruction counts of TIMER1_CAPT_vect: register saves, restores and calls out of it."""
+    output = subprocess.check_output([find_avr_tool("avr-objdump"), "-d", "--no-show-raw-insn", elf]).decode()
+    counts = {"instructions": 0, "push": 0, "pop": 0, "calls": 0}
+    inside = False
+    for line in output.splitlines():
+        if line.endswith(">:"):
+            inside = line.endswith("<%s>:" % ISR_SYMBOL)
+            continue
+        fields = line.split("\t")
+        if not inside or len(fields) < 2:
+            continue
+        mnemonic = fields[1].strip().split(" ")[0]
+        counts["instructions"] += 1
+        if mnemonic in ("push", "pop"):
+            counts[mnemonic] += 1
+        elif mnemonic in ("call", "rcall", "icall", "eicall"):
+            counts["calls"] += 1
+    return counts
+
+
+def run_simulation(harness, elf, raw, seconds):
+    result = subprocess.run([harness, elf, raw, str(seconds)], stdout=subprocess.PIPE,
+                            stderr=subprocess.PIPE, universal_newlines=True)
+    histograms = {}
+    cycles = 0
+    for line in result.stdout.splitlines():
+        fields = line.split()
+        if fields[0] == "isr":
+            tag, length, count = int(fields[1]), int(fields[2]), int(fields[3])
+            histograms.setdefault(tag, []).append((length, count))
+        elif fields[0] == "cycles":
+            cycles = int(fields[1])
+    if result.returncode != 0:
+        sys.stderr.write(result.stderr)
+        raise SystemExit("simbench did not finish the benchmark")
+    return histograms, cycles, result.stderr
+
+
+def sample_period(console):
+    """AUDIO_SAMPLE_PERIOD_CYCLES of the image, from its "Sample rate" boot message."""
+    found = re.search(r"(\d+) cycles per sample", console)
+    return int(found.group(1)) if found else SAMPLE_PERIOD_CYCLES
+
+
+def declared_cycles(console):
+    """{mode: cycles} of the image's "Declared cycles" boot messages (benchmarkSetup())."""
+    return {int(mode): int(cycles) for mode, cycles in re.findall(r"Declared cycles: (\d+) (\d+)", console)}
+
+
+def round_up(cycles, step=10):
+    return int(math.ceil(cycles / float(step))) * step
+
+
+def check_declared(report):
+    """Prints declared against measured cycles per mode and the constants that would cover
+    the measured maxima; True if no mode took more than declared."""
+    modes = {mode: stats for mode, stats in report["isr"].items() if "declared" in stats}
+    if not modes:
+        print("no declared cycles in the boot messages; is the image built with BENCHMARK?")
+        return False
+    ok = True
+    print("%-18s %8s %8s %8s" % ("mode", "declared", "max", "margin"))
+    for mode, stats in sorted(modes.items()):
+        margin = stats["declared"] - stats["max"]
+        print("%-18s %8d %8d %8d%s" % (mode, stats["declared"], stats["max"], margin,
+                                       "  <-- underestimate" if margin < 0 else ""))
+        ok = ok and margin >= 0
+    clean = modes.get("CLEAN_MODE")
+    if clean:
+        print("ISR_FIXED_CYCLES >= %d (CLEAN_MODE max)" % round_up(clean["max"]))
+        for mode, stats in sorted(modes.items()):
+            if mode != "CLEAN_MODE":
+                print("%-18s kernel >= %d cycles" % (mode, round_up(stats["max"] - clean["max"])))
+    return ok
+
+
+def effect_headers():
+    """[(path, modes)] of the headers declaring an effect: the modes its handles() names."""
+    headers = []
+    include = os.path.join(ROOT, "include")
+    for name in sorted(os.listdir(include)):
+        path = os.path.join(include, name)
+        with open(path) as header:
+            text = header.read()
+        handles = re.search(r"static constexpr bool handles\(EffectMode mode\)\s*{(.*?)}", text, re.S)
+        if handles and re.search(r"static constexpr uint16_t worstCaseCycles =", text):
+            headers.append((path, re.findall(r"mode == (\w+)", handles.group(1))))
+    return headers
+
+
+def replace_constant(path, pattern, value, revision):
+    """Rewrites the value a pattern's first group ends at, up to the end of its line."""
+    with open(path) as header:
+        text = header.read()
+    note = " // Measured max, tools/benchmark.py at %s" % revision
+    text, count = re.subn(pattern + r".*", lambda found: found.group(1) + value + note, text, count=1)
+    if count:
+        with open(path, "w") as header:
+            header.write(text)
+        print("%s: %s" % (os.path.relpath(path, ROOT), value))
+    return count == 1
+
+
+def apply_measured(report):
+    """Sets ISR_FIXED_CYCLES and each effect's worstCaseCycles to the rounded measured maxima."""
+    modes = report["isr"]
+    clean = modes.get("CLEAN_MODE")
+    if not clean:
+        raise SystemExit("--apply needs CLEAN_MODE in the report")
+    revision = report["revision"] or "unknown revision"
+    fixed = round_up(clean["max"])
+    replace_constant(os.path.join(ROOT, "include", "effectchain.h"), r"(#define ISR_FIXED_CYCLES )", str(fixed), revision)
+    for path, handled in effect_headers():
+        kernels = [modes[mode]["max"] - clean["max"] for mode in handled if mode in modes]
+        if not kernels:
+            print("%s: no mode measured, left as it was" % os.path.relpath(path, ROOT))
+            continue
+        replace_constant(path, r"(static constexpr uint16_t worstCaseCycles = )", "%d;" % round_up(max(kernels)), revision)
+
+
+def statistics(histogram, period):
+    """Count, min, max, mean, percentiles and overruns of a [(cycles, count)] histogram."""
+    histogram = sorted(histogram)
+    total = sum(count for _, count in histogram)
+    stats = {
+        "count": total,
+        "min": histogram[0][0],
+        "max": histogram[-1][0],
+        "mean": round(sum(length * count for length, count in histogram) / float(total), 1),
+    }
+    for percentile in PERCENTILES:
+        rank = int(math.ceil(percentile / 100.0 * total))
+        seen = 0
+        for length, count in histogram:
+            seen += count
+            if seen >= rank:
+                stats["p%g" % percentile] = length
+                break
+    stats["overruns"] = sum(count for length, count in histogram if length > period)
+    stats["headroom_cycles"] = period - stats["max"]
+    return stats
+
+
+def git_revision():
+    try:
+        return subprocess.check_output(["git", "describe", "--always", "--dirty"], cwd=ROOT).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def compare(report, baseline, tolerance):
+    """Prints max and p99 changes per mode, then flash and ISR code changes; True if no
+    mode's max grew beyond tolerance."""
+    ok = True
+    print("flash %d bytes (%+d)" % (report["memory"]["flash_bytes"],
+                                    report["memory"]["flash_bytes"] - baseline["memory"]["flash_bytes"]))
+    for key in ("push", "pop", "calls", "instructions"):
+        before = baseline.get("isr_code", {}).get(key)
+        print("ISR %-12s %5d%s" % (key, report["isr_code"][key],
+                                   " (%+d)" % (report["isr_code"][key] - before) if before is not None else ""))
+    print("%-18s %12s %12s" % ("mode", "max", "p99"))
+    for mode, stats in sorted(report["isr"].items()):
+        before = baseline["isr"].get(mode)
+        if not before:
+            print("%-18s %12s %12s" % (mode, "%d (new)" % stats["max"], stats["p99"]))
+            continue
+        grown = stats["max"] - before["max"]
+        print("%-18s %5d (%+4d) %5d (%+4d)%s" % (mode, stats["max"], grown, stats["p99"],
+                                                 stats["p99"] - before["p99"], "  <-- regression" if grown > tolerance else ""))
+        ok = ok and grown <= tolerance
+    return ok
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--output", default="benchmark.json", help="JSON report to write")
+    parser.add_argument("--input", help="raw 10-bit input (default: generated sweep)")
+    parser.add_argument("--elf", help="use this bench image instead of building one")
+    parser.add_argument("--seconds", type=float, default=10.0, help="simulated time limit")
+    parser.add_argument("--compare", help="earlier JSON report to compare against")
+    parser.add_argument("--tolerance", type=int, default=0, help="cycles a max may grow by in --compare")
+    parser.add_argument("--apply", action="store_true", help="write the measured maxima into the cycle constants")
+    args = parser.parse_args()
+
+    workdir = tempfile.mkdtemp(prefix="simbench")
+    try:
+        elf = args.elf or build_firmware()
+        harness = build_harness(workdir)
+        raw = args.input
+        if not raw:
+            raw = os.path.join(workdir, "input.raw")
+            default_input(raw)
+        histograms, cycles, console = run_simulation(harness, elf, raw, args.seconds)
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+    names = mode_names()
+    period = sample_period(console)
+    declared = declared_cycles(console)
+    report = {
+        "revision": git_revision(),
+        "f_cpu": F_CPU,
+        "sample_period_cycles": period,
+        "input": args.input or "generated sweep",
+        "simulated_seconds": round(cycles / float(F_CPU), 3),
+        "memory": memory_usage(elf),
+        "isr_code": isr_code(elf),
+        "isr": {},
+        "console": console.splitlines(),
+    }
+    for tag, histogram in sorted(histograms.items()):
+        if tag == TAG_TRANSITION:
+            report["isr"]["transition"] = statistics(histogram, period)
+        elif tag < len(names):
+            report["isr"][names[tag]] = statistics(histogram, period)
+            if tag in declared:
+                report["isr"][names[tag]]["declared"] = declared[tag]
+    with open(args.output, "w") as out:
+        json.dump(report, out, indent=2, sort_keys=True)
+        out.write("\n")
+
+    memory = report["memory"]
+    print("flash %d bytes (%.1f%%), static SRAM %d bytes (%.1f%%)" % (
+        memory["flash_bytes"], memory["flash_percent"], memory["sram_static_bytes"], memory["sram_percent"]))
+    code = report["isr_code"]
+    print("TIMER1_CAPT_vect: %d instructions, %d push, %d pop, %d calls" % (
+        code["instructions"], code["push"], code["pop"], code["calls"]))
+    for mode, stats in sorted(report["isr"].items()):
+        print("%-18s n=%-6d min %4d  p50 %4d  p99 %4d  max %4d  overruns %d" % (
+            mode, stats["count"], stats["min"], stats["p50"], stats["p99"], stats["max"], stats["overruns"]))
+    ok = check_declared(report)
+    if args.apply:
+        apply_measured(report)
+        ok = True  # The constants now cover this run; rebuild and rerun to check them
+    if args.compare:
+        with open(args.compare) as baseline:
+            ok = compare(report, json.load(baseline), args.tolerance) and ok
+    if not ok:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,81 @@
+"""Post-link SRAM check of the AVR images, run by PlatformIO (extra_scripts in platformio.ini).
+
+The effect arena (include/arena.h) is sized from STATIC_SRAM_BYTES, the static data of
+everything outside the arena, the parameter banks, the Serial object and the optional
+modules. This reads the linked image: avr-size gives .data + .bss, avr-nm the sizes of
+the budgeted symbols, and the rest is the real figure for STATIC_SRAM_BYTES. The build
+fails if that outgrows STATIC_SRAM_BYTES (printing the value to set), or if the static
+data leaves less than STACK_RESERVE_BYTES of the SRAM_BYTES for the stack, so a new global
+or a bigger Serial ring cannot quietly eat into it. arenaReport() checks the stack at boot,
+with the stack actually in use.
+"""
+import os
+import re
+import subprocess
+
+Import("env")  # noqa: F821 (provided by PlatformIO)
+
+# Globals with their own line in the budget of include/arena.h
+BUDGETED_SYMBOLS = (
+    "effectArena", "effectParamBanks", "Serial",
+    "isrProfileStats",                                              # ISR_PROFILE
+    "telemetryRing", "telemetryCapture",                            # TELEMETRY
+    "audioInBlock", "audioOutBlock", "audioBlockIndex", "audioBlockHalf",
+    "audioBlockReady", "audioBlockOverruns", "audioBlockBusy",      # AUDIO_BLOCK_MODE
+)
+
+
+def arena_define(name):
+    with open(os.path.join(env.subst("$PROJECT_DIR"), "include", "arena.h")) as header:  # noqa: F821
+        match = re.search(r"^#define %s (\d+)" % name, header.read(), re.M)
+    return int(match.group(1))
+
+
+def section_sizes(env, elf):
+    output = subprocess.check_output([env.subst("$SIZETOOL"), "-A", elf]).decode()
+    sections = {}
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[1].isdigit():
+            sections[fields[0]] = int(fields[1])
+    return sections
+
+
+def symbol_sizes(env, elf):
+    """Sizes of the data and bss symbols, by name (LTO suffixes dropped)."""
+    sizetool = env.subst("$SIZETOOL")
+    nm = os.path.join(os.path.dirname(sizetool), os.path.basename(sizetool).replace("size", "nm"))
+    symbols = {}
+    for line in subprocess.check_output([nm, "-S", elf]).decode().splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in "bBdD":
+            name = fields[3].split(".")[0]
+            symbols[name] = symbols.get(name, 0) + int(fields[1], 16)
+    return symbols
+
+
+def check_sram(target, source, env):
+    elf = str(target[0])
+    sections = section_sizes(env, elf)
+    static = sections.get(".data", 0) + sections.get(".bss", 0)
+    limit = arena_define("SRAM_BYTES") - arena_define("STACK_RESERVE_BYTES")
+    print("Static SRAM: %d of %d bytes (SRAM_BYTES - STACK_RESERVE_BYTES)" % (static, limit))
+
+    symbols = symbol_sizes(env, elf)
+    other = static - sum(symbols.get(name, 0) for name in BUDGETED_SYMBOLS)
+    estimate = arena_define("STATIC_SRAM_BYTES")
+    print("Other static data: %d of %d bytes (STATIC_SRAM_BYTES)" % (other, estimate))
+    failed = False
+    if other > estimate:
+        largest = sorted((size, name) for name, size in symbols.items() if name not in BUDGETED_SYMBOLS)[-8:]
+        print("ERROR: set STATIC_SRAM_BYTES in include/arena.h to %d; largest: %s"
+              % (other, ", ".join("%s %d" % (name, size) for size, name in reversed(largest))))
+        failed = True
+    if static > limit:
+        print("ERROR: static data leaves less than STACK_RESERVE_BYTES for the stack; "
+              "shrink the arena, the parameter banks or the Serial rings (include/arena.h)")
+        failed = True
+    return 1 if failed else 0
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", check_sram)  # noqa: F821
@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+"""Generates src/distortioncurves.cpp, the waveshaper tables used by the distortion effect.
+
+Each curve maps the pre-gained Q15 input (-1.0..+1.0, DISTORTION_CURVE_POINTS evenly
+spaced points) to the Q15 output sample. Every curve peaks at LEVEL, the clip threshold
+of the original hard clipper (150 of 512), so switching curves keeps the output level.
+
+    python3 tools/gen_distortion_curves.py > src/distortioncurves.cpp
+"""
+import math
+
+POINTS = 257
+LEVEL = 150.0 / 512.0
+TUBE_BIAS = 0.1  # Input offset of the tube curve; sets the amount of even harmonics
+
+
+def tanh_curve(x):
+    return LEVEL * math.tanh(x / LEVEL)
+
+
+def tube_curve(x):
+    bias = math.tanh(TUBE_BIAS / LEVEL)
+    peak = 1.0 + bias  # Negative side saturates hardest
+    return LEVEL * (math.tanh((x + TUBE_BIAS) / LEVEL) - bias) / peak
+
+
+def foldback_curve(x):
+    # Triangle fold: rises to LEVEL, then reflects back down each time it reaches +/- LEVEL
+    return LEVEL * (2.0 / math.pi) * math.asin(math.sin(x / LEVEL * math.pi / 2.0))
+
+
+def hard_curve(x):
+    return max(-LEVEL, min(LEVEL, x))
+
+
+CURVES = [
+    ("DISTORTION_CURVE_TANH", tanh_curve),
+    ("DISTORTION_CURVE_TUBE", tube_curve),
+    ("DISTORTION_CURVE_FOLDBACK", foldback_curve),
+    ("DISTORTION_CURVE_HARD", hard_curve),
+]
+
+
+def q15(v):
+    return max(-32768, min(32767, int(round(v * 32768.0))))
+
+
+def main():
+    print("/* Generated by tools/gen_distortion_curves.py - edit the script, not this file.*/")
+    print('#include "distortion.h"')
+    print()
+    print("const q15_t distortionCurves[NUM_DISTORTION_CURVES][DISTORTION_CURVE_POINTS] PROGMEM = {")
+    for name, curve in CURVES:
+        values = [q15(curve(-1.0 + 2.0 * i / (POINTS - 1))) for i in range(POINTS)]
+        print("    /*%s*/ {" % name)
+        for row in range(0, POINTS, 12):
+            print("        " + ", ".join("%d" % v for v in values[row:row + 12]) + ",")
+        print("    },")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,37 @@
+#!/usr/bin/env python3
+"""Generates src/gaintable.cpp, the log-taper master volume table (outputgain.h).
+
+Point i of OUTPUT_GAIN_TABLE_POINTS is the Q15 gain of volume setting 16 * i. The taper
+has two straight segments in dB: points 1..32 go from -RANGE_DB up to -MID_DB, and points
+32..64 from -MID_DB up to 0 dB (unity, saturated to 0x7FFF); point 0 is mute. MID_DB
+keeps the boot volume (512, mid-scale) at the level the pedal always had there: the
+original code scaled by 512/1024 at the input and by 512/1023 at the output, 0.25.
+
+    python3 tools/gen_gain_table.py > src/gaintable.cpp
+"""
+
+POINTS = 65
+RANGE_DB = 48.0
+MID_DB = 12.0
+MID_POINT = (POINTS - 1) // 2
+
+
+def main():
+    values = [0]
+    for i in range(1, POINTS):
+        if i <= MID_POINT:
+            db = -RANGE_DB + (RANGE_DB - MID_DB) * (i - 1) / (MID_POINT - 1)
+        else:
+            db = -MID_DB * (POINTS - 1 - i) / (POINTS - 1 - MID_POINT)
+        values.append(min(32767, int(round(10.0 ** (db / 20.0) * 32768.0))))
+    print("/* Generated by tools/gen_gain_table.py - edit the script, not this file.*/")
+    print('#include "outputgain.h"')
+    print()
+    print("const q15_t outputGainTable[OUTPUT_GAIN_TABLE_POINTS] PROGMEM = {")
+    for row in range(0, len(values), 12):
+        print("    " + ", ".join("%d" % v for v in values[row:row + 12]) + ",")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Generates test/test_kernels/golden.h, the reference outputs of the kernel tests.
+
+Runs every mode of the native build over the test signals of
+test/test_kernels/signals.h (reproduced here sample for sample) and records, per
+mode and signal, a summary of the 10-bit output: the first GOLDEN_HEAD samples, one
+sample every GOLDEN_STRIDE after that, and the RMS of each GOLDEN_WINDOW samples.
+
+    pio run -e native
+    python3 tools/gen_golden.py > test/test_kernels/golden.h
+
+Only regenerate after a change that is meant to alter the sound, and say so in the
+commit: the tests exist to catch the changes that are not.
+"""
+import argparse
+import math
+import os
+import re
+import struct
+import subprocess
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# test/test_kernels/signals.h
+SIGNAL_SAMPLES = 4096
+SIGNAL_IMPULSE_AT = 8
+SIGNAL_SWEEP_STEP = 6845000
+SIGNAL_SWEEP_RAMP = 165000
+SIGNAL_SWEEP_AMPLITUDE = 448
+SIGNAL_SQUARE_PERIOD = 72
+SIGNALS = ["SIGNAL_IMPULSE", "SIGNAL_SWEEP", "SIGNAL_SILENCE", "SIGNAL_FULL_SCALE"]
+
+GOLDEN_HEAD = 32
+GOLDEN_STRIDE = 128
+GOLDEN_WINDOW = 256
+
+# pedal_host -m names and the EffectMode each one runs
+MODES = [
+    ("clean", "CLEAN_MODE"),
+    ("normal", "NORMAL_MODE"),
+    ("reverb", "REVERB_ECHO_MODE"),
+    ("delay", "DELAY_MODE"),
+    ("echo", "ECHO_MODE"),
+    ("octaver", "OCTAVER_MODE"),
+    ("distortion", "DISTORTION_MODE"),
+    ("sinewave", "SINEWAVE_MODE"),
+    ("chorus", "CHORUS_MODE"),
+    ("flanger", "FLANGER_MODE"),
+    ("vibrato", "VIBRATO_MODE"),
+    ("tremolo", "TREMOLO_MODE"),
+    ("chain", "CHAIN_MODE"),
+    ("looper", "LOOPER_MODE"),
+]
+
+
+def signal_codes(signal):
+    if signal == "SIGNAL_IMPULSE":
+        return [1023 if n == SIGNAL_IMPULSE_AT else 512 for n in range(SIGNAL_SAMPLES)]
+    if signal == "SIGNAL_SWEEP":
+        codes = []
+        phase, step = 0, SIGNAL_SWEEP_STEP
+        for _ in range(SIGNAL_SAMPLES):
+            x = phase >> 16
+            x = x - 65536 if x >= 32768 else x
+            y = x * (32768 - abs(x))
+            codes.append(512 + ((y * SIGNAL_SWEEP_AMPLITUDE) >> 28))
+            phase = (phase + step) & 0xFFFFFFFF
+            step = (step + SIGNAL_SWEEP_RAMP) & 0xFFFFFFFF
+        return codes
+    if signal == "SIGNAL_FULL_SCALE":
+        return [1023 if n % SIGNAL_SQUARE_PERIOD < SIGNAL_SQUARE_PERIOD // 2 else 0 for n in range(SIGNAL_SAMPLES)]
+    return [512] * SIGNAL_SAMPLES
+
+
+def render(host, mode, codes):
+    """Output codes centered on 512, and the sample rate the build reports."""
+    result = subprocess.run([host, "-r", "-m", mode, "-", "-"], input=struct.pack("<%dH" % len(codes), *codes),
+                            stdout=subprocess.PIPE, stderr=subprocess.PIPE, check=True)
+    rate = int(re.search(rb"at (\d+) Hz", result.stderr).group(1))
+    output = result.stdout
+    return [code - 512 for code in struct.unpack("<%dH" % (len(output) // 2), output)], rate
+
+
+def summary(samples):
+    points = samples[GOLDEN_STRIDE // 2::GOLDEN_STRIDE]
+    windows = [samples[i:i + GOLDEN_WINDOW] for i in range(0, len(samples), GOLDEN_WINDOW)]
+    rms = [int(round(10.0 * math.sqrt(sum(s * s for s in w) / float(len(w))))) for w in windows]
+    return samples[:GOLDEN_HEAD], points, rms
+
+
+def row(values):
+    return "{" + ", ".join(str(v) for v in values) + "}"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default=os.path.join(ROOT, ".pio", "build", "native", "program"),
+                        help="native build to run (default: the pio native program)")
+    args = parser.parse_args()
+
+    cases = []
+    for name, mode in MODES:
+        for signal in SIGNALS:
+            samples, rate = render(args.host, name, signal_codes(signal))
+            cases.append((mode, signal, summary(samples)))
+
+    print("/* Generated by tools/gen_golden.py - edit the script, not this file.*/")
+    print("#ifndef GOLDEN_H")
+    print("#define GOLDEN_H")
+    print('#include "main.h"')
+    print('#include "signals.h"')
+    print("")
+    print("#define GOLDEN_SAMPLE_RATE_HZ %dUL // Of the build that made this file" % rate)
+    print("#define GOLDEN_HEAD %d   // Leading output samples kept" % GOLDEN_HEAD)
+    print("#define GOLDEN_STRIDE %d // Then one sample in GOLDEN_STRIDE, from GOLDEN_STRIDE / 2" % GOLDEN_STRIDE)
+    print("#define GOLDEN_POINTS %d" % (SIGNAL_SAMPLES // GOLDEN_STRIDE))
+    print("#define GOLDEN_WINDOW %d // RMS window, samples" % GOLDEN_WINDOW)
+    print("#define GOLDEN_WINDOWS %d" % (SIGNAL_SAMPLES // GOLDEN_WINDOW))
+    print("")
+    print("/*Output summary of one mode on one signal, in 10-bit codes centered on 512*/")
+    print("struct GoldenCase {")
+    print("    EffectMode mode;")
+    print("    uint8_t signal; // GoldenSignal")
+    print("    int16_t head[GOLDEN_HEAD];")
+    print("    int16_t points[GOLDEN_POINTS];")
+    print("    uint16_t rms[GOLDEN_WINDOWS]; // Tenths of a code")
+    print("};")
+    print("")
+    print("static const GoldenCase goldenCases[] = {")
+    for mode, signal, (head, points, rms) in cases:
+        print("    {%s, %s," % (mode, signal))
+        print("     %s," % row(head))
+        print("     %s," % row(points))
+        print("     %s}," % row(rms))
+    print("};")
+    print("")
+    print("#endif")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+"""Generates src/sinetable.cpp, the DDS sine table used by the sinewave generator.
+
+One full cycle in SINE_TABLE_SIZE Q15 entries plus a guard entry (a copy of entry 0),
+so interpolation between entry i and i + 1 never needs to wrap.
+
+    python3 tools/gen_sine_table.py > src/sinetable.cpp
+"""
+import math
+
+SIZE = 256
+
+
+def main():
+    values = [int(round(math.sin(2.0 * math.pi * i / SIZE) * 32767.0)) for i in range(SIZE)]
+    values.append(values[0])
+    print("/* Generated by tools/gen_sine_table.py - edit the script, not this file.*/")
+    print('#include "sinewave.h"')
+    print()
+    print("const q15_t sineTable[SINE_TABLE_SIZE + 1] PROGMEM = {")
+    for row in range(0, len(values), 12):
+        print("    " + ", ".join("%d" % v for v in values[row:row + 12]) + ",")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Reads and writes the pedal's effect parameters over serial (see include/serialcommands.h).
+
+    python3 tools/pedal_params.py /dev/ttyACM0 list
+    python3 tools/pedal_params.py /dev/ttyACM0 get echo.fdbk
+    python3 tools/pedal_params.py /dev/ttyACM0 set echo.fdbk 0.5
+    python3 tools/pedal_params.py /dev/ttyACM0 set sine.freq0 4400
+    python3 tools/pedal_params.py /dev/ttyACM0 save 2
+    python3 tools/pedal_params.py /dev/ttyACM0 load 2
+
+save and load store and recall the whole pedal state (mode, volume and every
+parameter) as user preset 1-4 in EEPROM; the last-used state is saved on its own.
+Q15 and Q7.8 parameters are shown and set as real numbers, integers as they are:
+delay times in microseconds, rates in 0.01 Hz, sine frequencies in 0.1 Hz.
+Needs pyserial. The port runs at SERIAL_BAUD (500000); opening it resets an Uno,
+so the script waits for the boot messages before it sends anything.
+"""
+import argparse
+import struct
+import sys
+import time
+
+SYNC = 0xA6
+BAUD = 500000
+NAME_CHARS = 12
+TYPES = ["u8", "u16", "q15", "q7.8"]
+STATUS = ["ok", "unknown parameter", "out of range", "bad frame", "busy, try again"]
+
+
+def encode_request(command, effect=0, param=0, value=0):
+    body = struct.pack("<BBBH", ord(command), effect, param, value & 0xFFFF)
+    return bytes([SYNC]) + body + bytes([sum(body) & 0xFF])
+
+
+def parse_replies(data):
+    """Yields (command, status, effect, param, payload) for every valid reply in data.
+    Telemetry frames and console text around the replies are skipped."""
+    i = 0
+    while i + 7 <= len(data):
+        if data[i] != SYNC:
+            i += 1
+            continue
+        length = data[i + 5]
+        end = i + 6 + length
+        if end >= len(data) or sum(data[i + 1:end]) & 0xFF != data[end]:
+            i += 1
+            continue
+        yield chr(data[i + 1]), data[i + 2], data[i + 3], data[i + 4], bytes(data[i + 6:end])
+        i = end + 1
+
+
+def decode_describe(payload):
+    kind, low, high, default = struct.unpack("<BHHH", payload[:7])
+    name = payload[7:7 + NAME_CHARS].split(b"\0")[0].decode("ascii")
+    return {"name": name, "type": kind, "min": low, "max": high, "default": default}
+
+
+def to_display(kind, raw):
+    if kind == 2:
+        return "%.4f" % (struct.unpack("<h", struct.pack("<H", raw))[0] / 32768.0)
+    if kind == 3:
+        return "%.3f" % (struct.unpack("<h", struct.pack("<H", raw))[0] / 256.0)
+    return str(raw)
+
+
+def from_display(kind, text):
+    if kind == 2:
+        return int(round(min(float(text), 32767 / 32768.0) * 32768)) & 0xFFFF
+    if kind == 3:
+        return int(round(float(text) * 256)) & 0xFFFF
+    return int(text, 0)
+
+
+class Pedal:
+    def __init__(self, port):
+        import serial
+        self.port = serial.Serial(port, BAUD, timeout=0.2)
+        time.sleep(2.0)  # Bootloader and setup() after the DTR reset
+        self.port.reset_input_buffer()
+
+    def request(self, command, effect=0, param=0, value=0):
+        self.port.write(encode_request(command, effect, param, value))
+        data = b""
+        deadline = time.time() + 1.0
+        while time.time() < deadline:
+            data += self.port.read(64)
+            for reply in parse_replies(data):
+                if reply[0] == command:
+                    return reply
+        raise RuntimeError("no reply to '%s'" % command)
+
+    def table(self):
+        _, _, _, _, payload = self.request("N")
+        entries = []
+        for effect, count in enumerate(payload[1:1 + payload[0]]):
+            for param in range(count):
+                _, status, _, _, info = self.request("D", effect, param)
+                if status == 0:
+                    entries.append((effect, param, decode_describe(info)))
+        return entries
+
+    def find(self, name):
+        for effect, param, info in self.table():
+            if info["name"] == name:
+                return effect, param, info
+        raise SystemExit("no parameter named %s" % name)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port")
+    parser.add_argument("command", choices=["list", "get", "set", "save", "load"])
+    parser.add_argument("name", nargs="?")
+    parser.add_argument("value", nargs="?")
+    args = parser.parse_args()
+
+    pedal = Pedal(args.port)
+    if args.command == "list":
+        for effect, param, info in pedal.table():
+            _, _, _, _, payload = pedal.request("G", effect, param)
+            kind = info["type"]
+            print("%-12s %-5s %10s  [%s .. %s] default %s" % (
+                info["name"], TYPES[kind], to_display(kind, struct.unpack("<H", payload)[0]),
+                to_display(kind, info["min"]), to_display(kind, info["max"]), to_display(kind, info["default"])))
+        return
+
+    if args.command in ("save", "load"):
+        _, status, _, _, _ = pedal.request("W" if args.command == "save" else "L", int(args.name))
+        if status:
+            print("error: %s" % STATUS[status], file=sys.stderr)
+        sys.exit(1 if status else 0)
+
+    effect, param, info = pedal.find(args.name)
+    if args.command == "get":
+        _, status, _, _, payload = pedal.request("G", effect, param)
+    else:
+        _, status, _, _, payload = pedal.request("S", effect, param, from_display(info["type"], args.value))
+    if status:
+        print("error: %s" % STATUS[status], file=sys.stderr)
+    print("%s = %s" % (args.name, to_display(info["type"], struct.unpack("<H", payload)[0])))
+    sys.exit(1 if status else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,184 @@
+/* Runs the bench firmware image (BENCHMARK, see include/benchmark.h) under simavr and
+ * counts the exact cycles of every TIMER1_CAPT_vect, from the vector fetch to its RETI.
+ * Driven by tools/benchmark.py; build with
+ *
+ *     cc -O2 -o simbench tools/simbench.c -lsimavr -lelf
+ *
+ * and run as
+ *
+ *     simbench firmware.elf input.raw [max_seconds]
+ *
+ * input.raw holds 10-bit ADC codes as little-endian uint16, fed to ADC0 one per
+ * conversion and repeated from the start when it runs out. The ISR tags itself in GPIOR0
+ * before it runs; once the firmware writes BENCHMARK_TAG_DONE (or max_seconds of
+ * simulated time pass) the histogram goes to stdout as
+ *
+ *     isr <tag> <cycles> <count>
+ *     cycles <simulated cycles>
+ *
+ * UART0 output (the boot messages) goes to stderr. When an ISR is interrupted by another
+ * (AUDIO_BLOCK_MODE re-enables interrupts for the block), the nested ISR's cycles are
+ * taken out of the outer one, so every line counts the work of one ISR alone.*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_irq.h>
+#include <simavr/avr_adc.h>
+#include <simavr/avr_uart.h>
+
+#define F_CPU 16000000UL
+#define VCC_MV 5000
+#define TIMER1_CAPT_VECTOR 10
+#define GPIOR0_ADDR 0x3E // I/O 0x1E in data space
+#define TAG_DONE 0xFF
+#define MAX_CYCLES 4096  // Longer ISRs are counted in the last bin
+#define MAX_DEPTH 8
+
+static avr_t *avr;
+static avr_irq_t *adcInput;
+static uint16_t *script;
+static size_t scriptLength, scriptPosition;
+
+static uint32_t histogram[256][MAX_CYCLES];
+static struct {
+    uint8_t tag;
+    avr_cycle_count_t start;
+    avr_cycle_count_t nested; // Cycles spent in ISRs that interrupted this one
+} stack[MAX_DEPTH];
+static int depth;
+static int done;
+
+/*********************************************FUNCTION DEFINITIONS****************************************************/
+/**
+ * @brief: Hands the next scripted code to ADC0 when a conversion starts.
+ */
+static void adcTrigger(avr_irq_t *irq, uint32_t value, void *param) {
+    (void)irq; (void)value; (void)param;
+    uint16_t code = script[scriptPosition];
+    scriptPosition = (scriptPosition + 1) % scriptLength;
+    avr_raise_irq(adcInput, (uint32_t)code * VCC_MV / 1024);
+}
+
+/**
+ * @brief: Opens (1) and closes (0, at RETI) a TIMER1_CAPT_vect measurement.
+ */
+static void isrRunning(avr_irq_t *irq, uint32_t value, void *param) {
+    (void)irq; (void)param;
+    if (value) {
+        if (depth == MAX_DEPTH) {
+            fprintf(stderr, "simbench: ISRs nested deeper than %d\n", MAX_DEPTH);
+            exit(1);
+        }
+        stack[depth].tag = avr->data[GPIOR0_ADDR];
+        stack[depth].start = avr->cycle;
+        stack[depth].nested = 0;
+        depth++;
+        return;
+    }
+    if (depth == 0) {
+        return;
+    }
+    depth--;
+    avr_cycle_count_t total = avr->cycle - stack[depth].start;
+    avr_cycle_count_t own = total - stack[depth].nested;
+    if (depth > 0) {
+        stack[depth - 1].nested += total;
+    }
+    histogram[stack[depth].tag][own < MAX_CYCLES ? own : MAX_CYCLES - 1]++;
+    if (stack[depth].tag == TAG_DONE) {
+        done = 1;
+    }
+}
+
+/**
+ * @brief: Echoes the firmware's serial output to stderr.
+ */
+static void uartOutput(avr_irq_t *irq, uint32_t value, void *param) {
+    (void)irq; (void)param;
+    fputc((int)value, stderr);
+}
+
+static uint16_t *readScript(const char *path, size_t *length) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        exit(1);
+    }
+    fseek(file, 0, SEEK_END);
+    long bytes = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    *length = (size_t)bytes / 2;
+    if (*length == 0) {
+        fprintf(stderr, "simbench: %s holds no samples\n", path);
+        exit(1);
+    }
+    uint16_t *codes = malloc(*length * sizeof(uint16_t));
+    for (size_t i = 0; i < *length; i++) {
+        uint8_t pair[2];
+        if (fread(pair, 1, 2, file) != 2) {
+            break;
+        }
+        codes[i] = (uint16_t)((pair[0] | (pair[1] << 8)) & 0x3FF);
+    }
+    fclose(file);
+    return codes;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s firmware.elf input.raw [max_seconds]\n", argv[0]);
+        return 2;
+    }
+    double maxSeconds = argc > 3 ? atof(argv[3]) : 10.0;
+    script = readScript(argv[2], &scriptLength);
+
+    elf_firmware_t firmware;
+    memset(&firmware, 0, sizeof(firmware));
+    if (elf_read_firmware(argv[1], &firmware) != 0) {
+        fprintf(stderr, "simbench: cannot read %s\n", argv[1]);
+        return 1;
+    }
+    strcpy(firmware.mmcu, "atmega328p");
+    firmware.frequency = F_CPU;
+    avr = avr_make_mcu_by_name(firmware.mmcu);
+    if (!avr) {
+        fprintf(stderr, "simbench: simavr has no atmega328p core\n");
+        return 1;
+    }
+    avr_init(avr);
+    avr_load_firmware(avr, &firmware);
+    avr->vcc = avr->avcc = avr->aref = VCC_MV;
+
+    adcInput = avr_io_getirq(avr, AVR_IOCTL_ADC_GETIRQ, ADC_IRQ_ADC0);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_ADC_GETIRQ, ADC_IRQ_OUT_TRIGGER), adcTrigger, NULL);
+    avr_irq_register_notify(avr_get_interrupt_irq(avr, TIMER1_CAPT_VECTOR) + AVR_INT_IRQ_RUNNING, isrRunning, NULL);
+
+    uint32_t flags = 0;
+    avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags);
+    flags &= ~AVR_UART_FLAG_STDIO;
+    avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT), uartOutput, NULL);
+
+    avr_cycle_count_t limit = (avr_cycle_count_t)(maxSeconds * F_CPU);
+    int state = cpu_Running;
+    while (!done && avr->cycle < limit && state != cpu_Done && state != cpu_Crashed) {
+        state = avr_run(avr);
+    }
+    if (!done) {
+        fprintf(stderr, "simbench: stopped before the benchmark finished (%s)\n",
+                state == cpu_Crashed ? "crashed" : "time limit");
+    }
+
+    for (int tag = 0; tag < 256; tag++) {
+        for (int cycles = 0; cycles < MAX_CYCLES; cycles++) {
+            if (histogram[tag][cycles]) {
+                printf("isr %d %d %u\n", tag, cycles, histogram[tag][cycles]);
+            }
+        }
+    }
+    printf("cycles %llu\n", (unsigned long long)avr->cycle);
+    return done ? 0 : 1;
+}
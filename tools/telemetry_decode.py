@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Decodes the pedal's TELEMETRY stream (see include/telemetry.h) into WAV or CSV.
+
+Record the raw serial bytes first, with the console at SERIAL_BAUD, e.g.
+
+    stty -F /dev/ttyACM0 500000 raw -echo && cat /dev/ttyACM0 > capture.bin
+    (send 'c' or 't' to the pedal to start a capture)
+
+then
+
+    python3 tools/telemetry_decode.py capture.bin --wav capture.wav --csv capture.csv
+
+Every frame is TELEMETRY_SYNC, type, a (int16 LE), b (int16 LE), checksum. Bytes that
+do not form a frame with a valid checksum (console text, line noise) are skipped.
+Each capture becomes one WAV file, 16-bit stereo: input on the left, output on the
+right, at the pedal rate divided by the decimation from its trigger record. A second
+capture in the same stream is written as name-1.wav, and so on. The CSV lists every
+record in stream order. A summary of modes, overruns and drops goes to stdout.
+"""
+import argparse
+import csv
+import os
+import struct
+import sys
+import wave
+
+F_CPU = 16000000
+SAMPLE_PERIOD_CYCLES = 510  # AUDIO_RATE_31K, see --period
+SYNC = 0xA5
+FRAME_BYTES = 7
+TYPES = {ord('S'): "sample", ord('T'): "trigger", ord('M'): "mode", ord('O'): "overrun", ord('D'): "dropped"}
+
+
+def frames(data):
+    """Yields (type, a, b) for every valid frame, resynchronising on bad bytes."""
+    i = 0
+    while i + FRAME_BYTES <= len(data):
+        if data[i] != SYNC or data[i + 1] not in TYPES:
+            i += 1
+            continue
+        body = data[i + 1:i + FRAME_BYTES - 1]
+        if sum(body) & 0xFF != data[i + FRAME_BYTES - 1]:
+            i += 1
+            continue
+        kind, a, b = struct.unpack("<Bhh", body)
+        yield TYPES[kind], a, b
+        i += FRAME_BYTES
+
+
+def numbered(path, index):
+    if index == 0:
+        return path
+    root, ext = os.path.splitext(path)
+    return "%s-%d%s" % (root, index, ext)
+
+
+def write_wav(path, rate, samples):
+    with wave.open(path, "wb") as out:
+        out.setnchannels(2)
+        out.setsampwidth(2)
+        out.setframerate(rate)
+        out.writeframes(b"".join(struct.pack("<hh", a, b) for a, b in samples))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="raw serial capture, - for stdin")
+    parser.add_argument("--wav", help="write each capture as a stereo WAV (input, output)")
+    parser.add_argument("--csv", help="write every record as CSV")
+    parser.add_argument("--period", type=int, default=SAMPLE_PERIOD_CYCLES,
+                        help="cycles per sample of the build, from its 'Sample rate' boot message")
+    args = parser.parse_args()
+
+    data = sys.stdin.buffer.read() if args.input == "-" else open(args.input, "rb").read()
+    records = list(frames(data))
+
+    captures = []  # [rate, [(in, out), ...]]
+    modes = []
+    overruns = 0
+    dropped = 0
+    for kind, a, b in records:
+        if kind == "trigger":
+            captures.append([round(F_CPU / args.period / b), []])
+        elif kind == "sample" and captures:
+            captures[-1][1].append((a, b))
+        elif kind == "mode":
+            modes.append(a)
+        elif kind == "overrun":
+            overruns = b & 0xFFFF
+        elif kind == "dropped":
+            dropped += a & 0xFFFF
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as out:
+            writer = csv.writer(out)
+            writer.writerow(["record", "type", "a", "b"])
+            for index, (kind, a, b) in enumerate(records):
+                writer.writerow([index, kind, a, b])
+    if args.wav:
+        for index, (rate, samples) in enumerate(captures):
+            write_wav(numbered(args.wav, index), rate, samples)
+
+    print("%d frames, %d captures (%s samples), modes %s, overruns %d, dropped %d" % (
+        len(records), len(captures), "/".join(str(len(c[1])) for c in captures) or "0",
+        modes, overruns, dropped))
+
+
+if __name__ == "__main__":
+    main()